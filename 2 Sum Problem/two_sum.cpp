@@ -7,18 +7,18 @@ vector<int> twosum(const vector<int> &nums, int target)
     unordered_map<int, int> num_map;
     vector<int> result;
 
-    for (int i = 0; i < nums.size(); i++)
+    for (size_t i = 0; i < nums.size(); i++)
     {
         int comp = target - nums[i];
 
         if (num_map.find(comp) != num_map.end())
         {
             result.push_back(num_map[comp]); // complement index
-            result.push_back(i);             // current element index
+            result.push_back((int)i);        // current element index
             return result;
         }
 
-        num_map[nums[i]] = i;
+        num_map[nums[i]] = (int)i;
     }
 
     return result;
@@ -0,0 +1,169 @@
+#ifndef ARENA_TREE_H
+#define ARENA_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// N-ary tree whose nodes live in one vector and refer to each other by
+// 32-bit index (first child / last child / next sibling / parent) instead of
+// owning pointers. Adding a node is a push_back; the whole tree is released
+// at once with the vector; nothing leaks.
+//
+// Level-order traversal comes in two speeds:
+//   * in general, levelOrder() runs a BFS whose queue is a scratch vector
+//     kept inside the tree, so repeated traversals allocate nothing;
+//   * after relayoutBfs() storage order *is* level order and every node's
+//     children are adjacent, so levelOrder() is a plain sequential scan of
+//     the node array. The tree stays in that layout until the next addChild.
+template <typename T>
+class ArenaTree
+{
+public:
+    typedef std::uint32_t NodeId;
+    static const NodeId none = 0xFFFFFFFFu;
+
+private:
+    struct Node
+    {
+        T value;
+        NodeId parent;
+        NodeId firstChild;
+        NodeId lastChild;
+        NodeId nextSibling;
+    };
+
+    std::vector<Node> nodes;
+    mutable std::vector<NodeId> scratch;
+    bool bfsLayout = true;
+
+    void check(NodeId id) const
+    {
+        if (id >= nodes.size())
+        {
+            throw std::out_of_range("ArenaTree: node id out of range");
+        }
+    }
+
+public:
+    explicit ArenaTree(const T &rootValue)
+    {
+        nodes.push_back(Node{rootValue, none, none, none, none});
+    }
+
+    NodeId root() const { return 0; }
+    std::size_t size() const { return nodes.size(); }
+    void reserve(std::size_t count) { nodes.reserve(count); }
+    bool inBfsLayout() const { return bfsLayout; }
+
+    NodeId addChild(NodeId parent, const T &value)
+    {
+        check(parent);
+        NodeId id = (NodeId)nodes.size();
+        if (id == none)
+        {
+            throw std::length_error("ArenaTree: too many nodes for 32-bit ids");
+        }
+        nodes.push_back(Node{value, parent, none, none, none});
+        Node &p = nodes[parent];
+        if (p.lastChild == none)
+        {
+            p.firstChild = id;
+        }
+        else
+        {
+            nodes[p.lastChild].nextSibling = id;
+        }
+        p.lastChild = id;
+        // Storage order stays level order as long as nodes are added to
+        // parents in non-decreasing id order.
+        if (bfsLayout && id > 1 && parent < nodes[id - 1].parent)
+        {
+            bfsLayout = false;
+        }
+        return id;
+    }
+
+    T &value(NodeId id) { return nodes[id].value; }
+    const T &value(NodeId id) const { return nodes[id].value; }
+    NodeId parent(NodeId id) const { return nodes[id].parent; }
+    NodeId firstChild(NodeId id) const { return nodes[id].firstChild; }
+    NodeId nextSibling(NodeId id) const { return nodes[id].nextSibling; }
+
+    template <typename Visit>
+    void forEachChild(NodeId id, Visit visit) const
+    {
+        for (NodeId child = nodes[id].firstChild; child != none; child = nodes[child].nextSibling)
+        {
+            visit(child);
+        }
+    }
+
+    // Calls visit(id) for every node in level order.
+    template <typename Visit>
+    void levelOrder(Visit visit) const
+    {
+        if (bfsLayout)
+        {
+            for (NodeId id = 0; id < nodes.size(); ++id)
+            {
+                visit(id);
+            }
+            return;
+        }
+        scratch.clear();
+        scratch.reserve(nodes.size());
+        scratch.push_back(root());
+        for (std::size_t head = 0; head < scratch.size(); ++head)
+        {
+            NodeId id = scratch[head];
+            visit(id);
+            for (NodeId child = nodes[id].firstChild; child != none; child = nodes[child].nextSibling)
+            {
+                scratch.push_back(child);
+            }
+        }
+    }
+
+    // Reorders the node array into level order. Returns the old -> new id map
+    // so handles held by the caller can be translated.
+    std::vector<NodeId> relayoutBfs()
+    {
+        std::vector<NodeId> order;
+        order.reserve(nodes.size());
+        levelOrder([&](NodeId id)
+                   { order.push_back(id); });
+
+        std::vector<NodeId> newId(nodes.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            newId[order[i]] = (NodeId)i;
+        }
+        auto remap = [&](NodeId id)
+        { return id == none ? none : newId[id]; };
+
+        std::vector<Node> laidOut;
+        laidOut.reserve(nodes.size());
+        for (NodeId old : order)
+        {
+            const Node &n = nodes[old];
+            laidOut.push_back(Node{std::move(nodes[old].value), remap(n.parent), remap(n.firstChild),
+                                   remap(n.lastChild), remap(n.nextSibling)});
+        }
+        nodes.swap(laidOut);
+        bfsLayout = true;
+        return newId;
+    }
+
+    std::size_t memoryBytes() const
+    {
+        return nodes.capacity() * sizeof(Node) + scratch.capacity() * sizeof(NodeId);
+    }
+};
+
+template <typename T>
+const typename ArenaTree<T>::NodeId ArenaTree<T>::none;
+
+#endif // ARENA_TREE_H
@@ -1,51 +1,76 @@
 #include <iostream>
 #include <vector>
-#include <queue>
+#include "csr_graph.h"
+#include "parallel_bfs.h"
 
 using namespace std;
 
 class Graph
 {
+private:
+    vector<CsrGraph::Edge> edges;
+    CsrGraph csr;
+    bool built = false;
+
+    // The CSR arrays are rebuilt only when edges were added since last time.
+    const CsrGraph &graph()
+    {
+        if (!built)
+        {
+            csr = CsrGraph::fromEdges(v, edges);
+            built = true;
+        }
+        return csr;
+    }
+
 public:
     int v;
-    vector<vector<int>> adj;
     Graph(int v)
     {
         this->v = v;
-        adj.resize(v);
     }
 
     void addEdge(int u, int v)
     {
-        adj[u].push_back(v);
-        adj[v].push_back(u);
+        edges.push_back({u, v, 0});
+        built = false;
     }
 
     void BFS(int start)
     {
+        const CsrGraph &g = graph();
         vector<bool> visited(v, false);
-        queue<int> q;
+        // Every vertex is enqueued at most once, so a flat array with a read
+        // index is the whole queue.
+        vector<int> queue;
+        queue.reserve(v);
         visited[start] = true;
-        q.push(start);
+        queue.push_back(start);
 
-        while (!q.empty())
+        for (size_t head = 0; head < queue.size(); head++)
         {
-            int node = q.front();
-            q.pop();
+            int node = queue[head];
             cout << node << " ";
 
-            for (int neighbor : adj[node])
+            for (int neighbor : g.neighborsOf(node))
             {
                 if (!visited[neighbor])
                 {
                     visited[neighbor] = true;
-                    q.push(neighbor);
+                    queue.push_back(neighbor);
                 }
             }
         }
 
         cout << endl;
     }
+
+    // Distances and BFS-tree parents from start, computed level by level on
+    // `threads` threads with direction-optimizing expansion; nothing is printed.
+    BfsResult shortestPaths(int start, unsigned threads = thread::hardware_concurrency())
+    {
+        return directionOptimizingBfs(graph(), start, threads);
+    }
 };
 
 int main()
@@ -57,5 +82,11 @@ int main()
     g.addEdge(1, 4);
     cout << "BFS stating from node 0:";
     g.BFS(0);
+
+    BfsResult result = g.shortestPaths(0, 2);
+    for (int node = 0; node < g.v; node++)
+    {
+        cout << "node " << node << ": distance " << result.distance[node] << ", parent " << result.parent[node] << endl;
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,148 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <utility>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Builds the same random undirected graph as vector<vector<int>> (what
+// bfs.cpp / dfs.cpp used to store) and as CsrGraph, then compares build time,
+// memory and BFS / DFS traversal time. CsrGraph::fromEdges keeps each
+// vertex's neighbors in edge order, so both copies must produce the same
+// visit sequence; the traversals fold it into an order-sensitive checksum.
+//
+// Usage: ./csrBenchmark [vertices] [averageDegree]   (default 1000000 8;
+//        pass 10000000 for the 10M-vertex run, ~2 GB for both copies)
+
+void report(const string &label, double seconds, size_t work)
+{
+    report(label, {{seconds, "s", 3}, {seconds * 1e9 / work, "ns/edge"}}, 28);
+}
+
+template <typename Neighbors>
+unsigned long long bfs(int n, Neighbors neighbors)
+{
+    vector<bool> visited(n, false);
+    vector<int> queue;
+    queue.reserve(n);
+    unsigned long long checksum = 0;
+    for (int root = 0; root < n; root++)
+    {
+        if (visited[root])
+            continue;
+        visited[root] = true;
+        queue.assign(1, root);
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            int node = queue[head];
+            checksum = checksum * 1000003 + node;
+            for (int next : neighbors(node))
+            {
+                if (!visited[next])
+                {
+                    visited[next] = true;
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+    return checksum;
+}
+
+template <typename Neighbors>
+unsigned long long dfs(int n, Neighbors neighbors)
+{
+    vector<bool> visited(n, false);
+    vector<pair<int, size_t>> stack;
+    unsigned long long checksum = 0;
+    for (int root = 0; root < n; root++)
+    {
+        if (visited[root])
+            continue;
+        visited[root] = true;
+        stack.push_back({root, 0});
+        while (!stack.empty())
+        {
+            int node = stack.back().first;
+            size_t &index = stack.back().second;
+            auto list = neighbors(node);
+            if (index == list.size())
+            {
+                checksum = checksum * 1000003 + node;
+                stack.pop_back();
+                continue;
+            }
+            int next = list[index++];
+            if (!visited[next])
+            {
+                visited[next] = true;
+                stack.push_back({next, 0});
+            }
+        }
+    }
+    return checksum;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int degree = argc > 2 ? atoi(argv[2]) : 8;
+
+    mt19937 rng(5);
+    vector<CsrGraph::Edge> edges((size_t)n * degree / 2);
+    for (CsrGraph::Edge &e : edges)
+    {
+        e = {(int)(rng() % n), (int)(rng() % n), 0};
+    }
+    size_t arcs = edges.size() * 2;
+    cout << "Graph: " << n << " vertices, " << edges.size() << " undirected edges" << endl;
+
+    double before = residentMiB();
+    vector<vector<int>> adj;
+    double seconds = timeIt([&]()
+                            {
+        adj.resize(n);
+        for (const CsrGraph::Edge &e : edges)
+        {
+            adj[e.from].push_back(e.to);
+            adj[e.to].push_back(e.from);
+        } });
+    double adjMiB = residentMiB() - before;
+    report("build vector<vector<int>>", seconds, arcs);
+
+    before = residentMiB();
+    CsrGraph csr;
+    seconds = timeIt([&]()
+                     { csr = CsrGraph::fromEdges(n, edges); });
+    double csrMiB = residentMiB() - before;
+    report("build CsrGraph", seconds, arcs);
+
+    auto adjNeighbors = [&](int v) -> const vector<int> &
+    { return adj[v]; };
+    auto csrNeighbors = [&](int v)
+    { return csr.neighborsOf(v); };
+
+    unsigned long long a = 0, b = 0;
+    report("BFS vector<vector<int>>", timeIt([&]()
+                                             { a = bfs(n, adjNeighbors); }),
+           arcs);
+    report("BFS CsrGraph", timeIt([&]()
+                                  { b = bfs(n, csrNeighbors); }),
+           arcs);
+    bool same = a == b;
+    report("DFS vector<vector<int>>", timeIt([&]()
+                                             { a = dfs(n, adjNeighbors); }),
+           arcs);
+    report("DFS CsrGraph", timeIt([&]()
+                                  { b = dfs(n, csrNeighbors); }),
+           arcs);
+    same = same && a == b;
+
+    report("memory vector<vector<int>>", {{adjMiB, "MiB RSS", 1}}, 28);
+    report("memory CsrGraph", {{csrMiB, "MiB RSS", 1}, {csr.memoryBytes() / 1048576.0, "MiB arrays", 1}}, 28);
+    cout << "Traversals agree: " << (same ? "yes" : "NO") << endl;
+    return same ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Immutable graph in compressed sparse row form.
+//
+// The neighbours of vertex v are neighbors[offsets[v] .. offsets[v + 1]),
+// and, for weighted graphs, weights[] is parallel to neighbors[]. The whole
+// graph is three flat arrays: no allocation per vertex, and a traversal reads
+// each adjacency list as one contiguous run.
+//
+// Built once from an edge list: one pass counts degrees, a prefix sum turns
+// them into offsets, and a second pass scatters the edges into place, so
+// building is O(V + E) with no sorting. Edges keep their input order within
+// each vertex, like push_back into vector<vector<int>> would.
+class CsrGraph
+{
+public:
+    typedef std::uint32_t EdgeIndex;
+
+    struct Edge
+    {
+        int from;
+        int to;
+        int weight;
+    };
+
+    // Iterable view of one adjacency list.
+    class Range
+    {
+    private:
+        const int *first;
+        const int *last;
+
+    public:
+        Range(const int *first, const int *last) : first(first), last(last) {}
+        const int *begin() const { return first; }
+        const int *end() const { return last; }
+        std::size_t size() const { return last - first; }
+        int operator[](std::size_t i) const { return first[i]; }
+    };
+
+private:
+    int vertexCount = 0;
+    std::vector<EdgeIndex> offsets;
+    std::vector<int> neighbors;
+    std::vector<int> weights;
+
+public:
+    CsrGraph() : offsets(1, 0) {}
+
+    // undirected: every edge is stored in both directions (like addEdge in
+    // bfs.cpp / dfs.cpp). weighted: keep Edge::weight for every arc.
+    static CsrGraph fromEdges(int vertexCount, const std::vector<Edge> &edges,
+                              bool undirected = true, bool weighted = false)
+    {
+        std::size_t arcs = edges.size() * (undirected ? 2 : 1);
+        if (arcs > std::numeric_limits<EdgeIndex>::max())
+        {
+            throw std::length_error("CsrGraph: too many edges for 32-bit offsets");
+        }
+
+        CsrGraph g;
+        g.vertexCount = vertexCount;
+        g.offsets.assign(vertexCount + 1, 0);
+        for (const Edge &e : edges)
+        {
+            if (e.from < 0 || e.from >= vertexCount || e.to < 0 || e.to >= vertexCount)
+            {
+                throw std::out_of_range("CsrGraph: edge endpoint out of range");
+            }
+            g.offsets[e.from + 1]++;
+            if (undirected)
+            {
+                g.offsets[e.to + 1]++;
+            }
+        }
+        for (int v = 0; v < vertexCount; v++)
+        {
+            g.offsets[v + 1] += g.offsets[v];
+        }
+
+        g.neighbors.resize(arcs);
+        if (weighted)
+        {
+            g.weights.resize(arcs);
+        }
+        std::vector<EdgeIndex> cursor(g.offsets.begin(), g.offsets.end() - 1);
+        for (const Edge &e : edges)
+        {
+            EdgeIndex slot = cursor[e.from]++;
+            g.neighbors[slot] = e.to;
+            if (weighted)
+            {
+                g.weights[slot] = e.weight;
+            }
+            if (undirected)
+            {
+                slot = cursor[e.to]++;
+                g.neighbors[slot] = e.from;
+                if (weighted)
+                {
+                    g.weights[slot] = e.weight;
+                }
+            }
+        }
+        return g;
+    }
+
+    // Converts an existing vector<vector<int>> adjacency list as is.
+    static CsrGraph fromAdjacency(const std::vector<std::vector<int>> &adj)
+    {
+        CsrGraph g;
+        g.vertexCount = (int)adj.size();
+        g.offsets.assign(adj.size() + 1, 0);
+        for (std::size_t v = 0; v < adj.size(); v++)
+        {
+            g.offsets[v + 1] = g.offsets[v] + (EdgeIndex)adj[v].size();
+        }
+        g.neighbors.reserve(g.offsets.back());
+        for (const std::vector<int> &list : adj)
+        {
+            g.neighbors.insert(g.neighbors.end(), list.begin(), list.end());
+        }
+        return g;
+    }
+
+    // Same graph with every arc flipped (weights follow their arcs).
+    CsrGraph reversed() const
+    {
+        CsrGraph r;
+        r.vertexCount = vertexCount;
+        r.offsets.assign(vertexCount + 1, 0);
+        for (int to : neighbors)
+        {
+            r.offsets[to + 1]++;
+        }
+        for (int v = 0; v < vertexCount; v++)
+        {
+            r.offsets[v + 1] += r.offsets[v];
+        }
+        r.neighbors.resize(neighbors.size());
+        r.weights.resize(weights.size());
+        std::vector<EdgeIndex> cursor(r.offsets.begin(), r.offsets.end() - 1);
+        for (int from = 0; from < vertexCount; from++)
+        {
+            for (EdgeIndex e = offsets[from]; e < offsets[from + 1]; e++)
+            {
+                EdgeIndex slot = cursor[neighbors[e]]++;
+                r.neighbors[slot] = from;
+                if (!weights.empty())
+                {
+                    r.weights[slot] = weights[e];
+                }
+            }
+        }
+        return r;
+    }
+
+    int numVertices() const { return vertexCount; }
+    std::size_t numArcs() const { return neighbors.size(); }
+    bool weighted() const { return !weights.empty(); }
+
+    std::size_t degree(int v) const { return offsets[v + 1] - offsets[v]; }
+
+    Range neighborsOf(int v) const
+    {
+        const int *base = neighbors.data();
+        return Range(base + offsets[v], base + offsets[v + 1]);
+    }
+
+    // Weights parallel to neighborsOf(v); only for weighted graphs.
+    Range weightsOf(int v) const
+    {
+        const int *base = weights.data();
+        return Range(base + offsets[v], base + offsets[v + 1]);
+    }
+
+    // Raw arrays, for algorithms that index edges directly.
+    EdgeIndex edgeBegin(int v) const { return offsets[v]; }
+    EdgeIndex edgeEnd(int v) const { return offsets[v + 1]; }
+    int target(EdgeIndex e) const { return neighbors[e]; }
+
+    std::size_t memoryBytes() const
+    {
+        return offsets.capacity() * sizeof(EdgeIndex) + neighbors.capacity() * sizeof(int) +
+               weights.capacity() * sizeof(int);
+    }
+};
+
+#endif // CSR_GRAPH_H
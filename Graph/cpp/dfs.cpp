@@ -1,5 +1,8 @@
 #include <iostream>
 #include <vector>
+#include <utility>
+#include "csr_graph.h"
+#include "dfs_engine.h"
 
 using namespace std;
 
@@ -7,45 +10,58 @@ class DFS
 {
 private:
     int v;
-    vector<vector<int>> adj;
+    vector<CsrGraph::Edge> edges;
+    CsrGraph csr;
+    bool built = false;
 
-    void DFSUtil(int node, vector<bool> &visited)
+    const CsrGraph &graph()
     {
-        visited[node] = true;
-        cout << node << " ";
-
-        for (int neighbor : adj[node])
+        if (!built)
         {
-            if (!visited[neighbor])
-            {
-                DFSUtil(neighbor, visited);
-            }
+            csr = CsrGraph::fromEdges(v, edges);
+            built = true;
         }
-        // cout << endl;
+        return csr;
+    }
+
+    // Same visiting order as the recursive version, driven by the explicit
+    // stack engine in dfs_engine.h, so long paths cannot overflow the stack.
+    void DFSUtil(int start, vector<unsigned char> &color)
+    {
+        vector<pair<int, CsrGraph::EdgeIndex>> stack;
+        dfsFrom(
+            graph(), start, color, stack, [](int node, int)
+            { cout << node << " "; },
+            DfsIgnore(), DfsIgnore());
     }
 
 public:
     DFS(int v)
     {
         this->v = v;
-        adj.resize(v);
     }
     void addEdge(int u, int v)
     {
-        adj[u].push_back(v);
-        adj[v].push_back(u);
+        edges.push_back({u, v, 0});
+        built = false;
     }
 
     void DFSuse(int start)
     {
-        vector<bool> visited(v, false);
-        DFSUtil(start, visited);
+        vector<unsigned char> color(v, DFS_NEW);
+        DFSUtil(start, color);
+    }
+
+    int countComponents()
+    {
+        vector<int> component;
+        return connectedComponents(graph(), component);
     }
 };
 
 int main()
 {
-    DFS g(5);
+    DFS g(8);
     g.addEdge(0, 1);
     g.addEdge(0, 2);
 
@@ -55,6 +71,26 @@ int main()
     cout << "DFS starting from node 0: ";
     g.DFSuse(0);
 
+    cout << endl;
+
+    g.addEdge(5, 6);
+    cout << "Connected components after adding 5-6 (with isolated 7): " << g.countComponents() << endl;
+
+    // Directed graph: 0 -> 1 -> 2 -> 0 is a cycle, 3 -> 4 is acyclic.
+    vector<CsrGraph::Edge> arcs = {{0, 1, 0}, {1, 2, 0}, {2, 0, 0}, {2, 3, 0}, {3, 4, 0}};
+    CsrGraph directed = CsrGraph::fromEdges(5, arcs, false);
+    vector<int> scc;
+    cout << "Strongly connected components: " << stronglyConnectedComponents(directed, scc) << endl;
+    cout << "Has cycle: " << (hasCycle(directed) ? "yes" : "no") << endl;
+
+    arcs.erase(arcs.begin() + 2);
+    vector<int> order;
+    topologicalSort(CsrGraph::fromEdges(5, arcs, false), order);
+    cout << "Topological order without 2 -> 0: ";
+    for (int node : order)
+    {
+        cout << node << " ";
+    }
     cout << endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,115 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "dfs_engine.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Times the explicit-stack DFS algorithms on
+//   chain   - 0 -> 1 -> ... -> n-1, the worst case for recursion depth
+//   ring    - the chain closed into one big cycle (a single SCC)
+//   random  - n vertices, n * degree random arcs
+//   dag     - the random arcs oriented from smaller to larger vertex
+// and cross-checks Tarjan against Kosaraju and every topological order.
+//
+// Usage: ./dfsBenchmark [vertices] [averageDegree]   (default 1000000 4)
+
+void report(const string &label, const CsrGraph &g, double seconds)
+{
+    report(label, {{seconds * 1e3, "ms", 3}, {seconds * 1e9 / (g.numVertices() + g.numArcs()), "ns/(V+E)"}}, 28);
+}
+
+// Same partition, possibly different numbering.
+bool samePartition(const vector<int> &a, const vector<int> &b)
+{
+    vector<int> map(a.size(), -1);
+    for (size_t v = 0; v < a.size(); v++)
+    {
+        if (map[a[v]] < 0)
+            map[a[v]] = b[v];
+        else if (map[a[v]] != b[v])
+            return false;
+    }
+    return true;
+}
+
+bool isTopological(const CsrGraph &g, const vector<int> &order)
+{
+    vector<int> position(g.numVertices());
+    for (size_t i = 0; i < order.size(); i++)
+        position[order[i]] = (int)i;
+    for (int u = 0; u < g.numVertices(); u++)
+        for (int v : g.neighborsOf(u))
+            if (position[u] >= position[v])
+                return false;
+    return order.size() == (size_t)g.numVertices();
+}
+
+bool runSuite(const string &name, const CsrGraph &g)
+{
+    benchSection(name, to_string(g.numVertices()) + " vertices, " + to_string(g.numArcs()) + " arcs");
+    vector<int> tarjan, kosaraju, order;
+    int tarjanCount = 0, kosarajuCount = 0;
+    bool cycle = false, sorted = false;
+
+    double seconds = timeIt([&]()
+                            { cycle = hasCycle(g); });
+    report("  hasCycle", g, seconds);
+    seconds = timeIt([&]()
+                     { sorted = topologicalSort(g, order); });
+    report("  topologicalSort", g, seconds);
+    seconds = timeIt([&]()
+                     { tarjanCount = stronglyConnectedComponents(g, tarjan); });
+    report("  Tarjan SCC", g, seconds);
+    seconds = timeIt([&]()
+                     { kosarajuCount = kosarajuComponents(g, kosaraju); });
+    report("  Kosaraju SCC", g, seconds);
+
+    CsrGraph undirected = CsrGraph::fromEdges(g.numVertices(), [&]()
+                                              {
+        vector<CsrGraph::Edge> edges;
+        for (int u = 0; u < g.numVertices(); u++)
+            for (int v : g.neighborsOf(u))
+                edges.push_back({u, v, 0});
+        return edges; }());
+    vector<int> component;
+    int components = 0;
+    seconds = timeIt([&]()
+                     { components = connectedComponents(undirected, component); });
+    report("  connectedComponents", undirected, seconds);
+
+    bool ok = tarjanCount == kosarajuCount && samePartition(tarjan, kosaraju) && samePartition(kosaraju, tarjan) &&
+              cycle == !sorted && (!sorted || isTopological(g, order));
+    cout << "  checks: " << (ok ? "ok" : "FAILED") << endl
+         << endl;
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int degree = argc > 2 ? atoi(argv[2]) : 4;
+
+    vector<CsrGraph::Edge> chain;
+    for (int v = 0; v + 1 < n; v++)
+        chain.push_back({v, v + 1, 0});
+    bool ok = runSuite("chain", CsrGraph::fromEdges(n, chain, false));
+    chain.push_back({n - 1, 0, 0});
+    ok = runSuite("ring", CsrGraph::fromEdges(n, chain, false)) && ok;
+
+    mt19937 rng(13);
+    vector<CsrGraph::Edge> random((size_t)n * degree);
+    for (CsrGraph::Edge &e : random)
+        e = {(int)(rng() % n), (int)(rng() % n), 0};
+    ok = runSuite("random", CsrGraph::fromEdges(n, random, false)) && ok;
+
+    vector<CsrGraph::Edge> dag;
+    for (const CsrGraph::Edge &e : random)
+        if (e.from != e.to)
+            dag.push_back({min(e.from, e.to), max(e.from, e.to), 0});
+    ok = runSuite("dag", CsrGraph::fromEdges(n, dag, false)) && ok;
+    return ok ? 0 : 1;
+}
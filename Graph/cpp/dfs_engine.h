@@ -0,0 +1,207 @@
+#ifndef DFS_ENGINE_H
+#define DFS_ENGINE_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+
+// Depth-first search without recursion, plus the classic algorithms built on
+// it. The call stack is replaced by a vector of (vertex, next edge offset)
+// frames, so a million-vertex path needs a few MB of heap instead of
+// overflowing the thread stack, and every algorithm below runs in O(V + E).
+//
+// The engine reports events through callbacks:
+//   pre(v, parent)            v is discovered (parent == -1 for a root)
+//   post(v, parent)           all of v's edges are done
+//   nonTree(u, v, colorOfV)   edge u -> v leads to an already discovered v;
+//                             colorOfV is DFS_ACTIVE for a back edge (v is on
+//                             the current path) and DFS_DONE otherwise
+enum DfsColor : unsigned char
+{
+    DFS_NEW = 0,
+    DFS_ACTIVE = 1,
+    DFS_DONE = 2
+};
+
+struct DfsIgnore
+{
+    void operator()(int, int) const {}
+    void operator()(int, int, unsigned char) const {}
+};
+
+template <typename Pre, typename Post, typename NonTree>
+void dfsFrom(const CsrGraph &g, int root, std::vector<unsigned char> &color,
+             std::vector<std::pair<int, CsrGraph::EdgeIndex>> &stack,
+             Pre pre, Post post, NonTree nonTree)
+{
+    color[root] = DFS_ACTIVE;
+    pre(root, -1);
+    stack.push_back({root, g.edgeBegin(root)});
+    while (!stack.empty())
+    {
+        int u = stack.back().first;
+        CsrGraph::EdgeIndex &next = stack.back().second;
+        if (next == g.edgeEnd(u))
+        {
+            stack.pop_back();
+            color[u] = DFS_DONE;
+            post(u, stack.empty() ? -1 : stack.back().first);
+            continue;
+        }
+        int v = g.target(next++);
+        if (color[v] == DFS_NEW)
+        {
+            color[v] = DFS_ACTIVE;
+            pre(v, u);
+            stack.push_back({v, g.edgeBegin(v)});
+        }
+        else
+        {
+            nonTree(u, v, color[v]);
+        }
+    }
+}
+
+// Runs dfsFrom from every still undiscovered vertex, in the given root order
+// (0, 1, 2, ... when roots is empty).
+template <typename Pre, typename Post, typename NonTree>
+void dfsForest(const CsrGraph &g, Pre pre, Post post, NonTree nonTree,
+               const std::vector<int> &roots = std::vector<int>())
+{
+    std::vector<unsigned char> color(g.numVertices(), DFS_NEW);
+    std::vector<std::pair<int, CsrGraph::EdgeIndex>> stack;
+    int count = roots.empty() ? g.numVertices() : (int)roots.size();
+    for (int i = 0; i < count; i++)
+    {
+        int root = roots.empty() ? i : roots[i];
+        if (color[root] == DFS_NEW)
+        {
+            dfsFrom(g, root, color, stack, pre, post, nonTree);
+        }
+    }
+}
+
+// Connected components of an undirected (symmetric) graph. component[v] is
+// numbered 0.. in order of the smallest vertex; returns the count.
+inline int connectedComponents(const CsrGraph &g, std::vector<int> &component)
+{
+    component.assign(g.numVertices(), -1);
+    int count = 0;
+    dfsForest(
+        g, [&](int v, int parent)
+        {
+            if (parent < 0)
+                ++count;
+            component[v] = count - 1; },
+        DfsIgnore(), DfsIgnore());
+    return count;
+}
+
+// True if a directed graph has a cycle (some edge closes back onto the path).
+inline bool hasCycle(const CsrGraph &g)
+{
+    bool cycle = false;
+    dfsForest(g, DfsIgnore(), DfsIgnore(), [&](int, int, unsigned char colorOfV)
+              {
+        if (colorOfV == DFS_ACTIVE)
+            cycle = true; });
+    return cycle;
+}
+
+// Topological order of a directed graph (reverse postorder). Returns false
+// and leaves order empty if the graph has a cycle.
+inline bool topologicalSort(const CsrGraph &g, std::vector<int> &order)
+{
+    bool cycle = false;
+    order.clear();
+    order.reserve(g.numVertices());
+    dfsForest(
+        g, DfsIgnore(), [&](int v, int)
+        { order.push_back(v); },
+        [&](int, int, unsigned char colorOfV)
+        {
+            if (colorOfV == DFS_ACTIVE)
+                cycle = true;
+        });
+    if (cycle)
+    {
+        order.clear();
+        return false;
+    }
+    std::reverse(order.begin(), order.end());
+    return true;
+}
+
+// Strongly connected components, Tarjan's algorithm on the engine: low-links
+// are pushed to the parent in post() instead of after a recursive call.
+// Components are numbered in reverse topological order of the condensation
+// (a component is numbered before every component that reaches it).
+inline int stronglyConnectedComponents(const CsrGraph &g, std::vector<int> &component)
+{
+    const int n = g.numVertices();
+    std::vector<int> index(n, -1), low(n, 0);
+    std::vector<int> sccStack;
+    std::vector<bool> onStack(n, false);
+    component.assign(n, -1);
+    int counter = 0, count = 0;
+
+    dfsForest(
+        g,
+        [&](int v, int)
+        {
+            index[v] = low[v] = counter++;
+            sccStack.push_back(v);
+            onStack[v] = true;
+        },
+        [&](int v, int parent)
+        {
+            if (low[v] == index[v])
+            {
+                int w;
+                do
+                {
+                    w = sccStack.back();
+                    sccStack.pop_back();
+                    onStack[w] = false;
+                    component[w] = count;
+                } while (w != v);
+                ++count;
+            }
+            if (parent >= 0)
+                low[parent] = std::min(low[parent], low[v]);
+        },
+        [&](int u, int v, unsigned char)
+        {
+            if (onStack[v])
+                low[u] = std::min(low[u], index[v]);
+        });
+    return count;
+}
+
+// Kosaraju's algorithm: postorder on g, then a forest on the reversed graph
+// taking roots in decreasing finish time. Same components as Tarjan, but
+// numbered in topological order of the condensation; costs a transpose.
+inline int kosarajuComponents(const CsrGraph &g, std::vector<int> &component)
+{
+    std::vector<int> finish;
+    finish.reserve(g.numVertices());
+    dfsForest(
+        g, DfsIgnore(), [&](int v, int)
+        { finish.push_back(v); },
+        DfsIgnore());
+    std::reverse(finish.begin(), finish.end());
+
+    component.assign(g.numVertices(), -1);
+    int count = 0;
+    dfsForest(
+        g.reversed(), [&](int v, int parent)
+        {
+            if (parent < 0)
+                ++count;
+            component[v] = count - 1; },
+        DfsIgnore(), DfsIgnore(), finish);
+    return count;
+}
+
+#endif // DFS_ENGINE_H
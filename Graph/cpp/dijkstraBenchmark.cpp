@@ -0,0 +1,136 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include "../../Tree/indexed_heap.h"
+#include "../../Tree/pairing_heap.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Dijkstra on a random sparse graph with three priority queues:
+//   lazy     - std::priority_queue, push a duplicate on every relaxation and
+//              skip stale entries when they are popped (Graph/MST/mst.md style)
+//   indexed  - IndexedHeap with decreaseKey, at most one entry per vertex
+//   pairing  - PairingHeap with O(1) decreaseKey
+// and reports time, number of pops and peak number of heap entries.
+//
+// Usage: ./dijkstraBenchmark [vertices] [averageDegree]   (default 1000000 8)
+
+struct Edge
+{
+    int to;
+    int weight;
+};
+
+struct Result
+{
+    vector<long long> dist;
+    size_t pops = 0;
+    size_t peakEntries = 0;
+    size_t heapBytes = 0;
+    double seconds = 0;
+};
+
+const long long INF = (long long)4e18;
+
+Result dijkstraLazy(const vector<vector<Edge>> &adj, int source)
+{
+    Result r;
+    auto start = chrono::steady_clock::now();
+    r.dist.assign(adj.size(), INF);
+    priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<pair<long long, int>>> pq;
+    r.dist[source] = 0;
+    pq.push({0, source});
+    while (!pq.empty())
+    {
+        r.peakEntries = max(r.peakEntries, pq.size());
+        long long d = pq.top().first;
+        int u = pq.top().second;
+        pq.pop();
+        r.pops++;
+        if (d > r.dist[u])
+        {
+            continue;
+        }
+        for (const Edge &e : adj[u])
+        {
+            if (d + e.weight < r.dist[e.to])
+            {
+                r.dist[e.to] = d + e.weight;
+                pq.push({r.dist[e.to], e.to});
+            }
+        }
+    }
+    r.heapBytes = r.peakEntries * sizeof(pair<long long, int>);
+    r.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+template <typename Heap>
+Result dijkstraAddressable(const vector<vector<Edge>> &adj, int source)
+{
+    Result r;
+    auto start = chrono::steady_clock::now();
+    r.dist.assign(adj.size(), INF);
+    Heap heap(adj.size());
+    r.dist[source] = 0;
+    heap.push(source, 0);
+    while (!heap.empty())
+    {
+        r.peakEntries = max(r.peakEntries, heap.size());
+        int u = (int)heap.pop();
+        r.pops++;
+        long long d = r.dist[u];
+        for (const Edge &e : adj[u])
+        {
+            if (d + e.weight < r.dist[e.to])
+            {
+                r.dist[e.to] = d + e.weight;
+                heap.pushOrUpdate(e.to, r.dist[e.to]);
+            }
+        }
+    }
+    r.heapBytes = heap.memoryBytes();
+    r.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+void report(const string &label, const Result &r)
+{
+    report(label, {{r.seconds, "s", 3}, {(double)r.pops, "pops", 0}, {(double)r.peakEntries, "peak entries", 0}, {r.heapBytes / 1048576.0, "MiB", 1}}, 12);
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int degree = argc > 2 ? atoi(argv[2]) : 8;
+
+    mt19937 rng(7);
+    vector<vector<Edge>> adj(n);
+    for (int u = 0; u < n; u++)
+    {
+        // A ring keeps the graph connected; the rest of the edges are random.
+        adj[u].push_back({(u + 1) % n, 1 + (int)(rng() % 1000)});
+        for (int i = 1; i < degree; i++)
+        {
+            adj[u].push_back({(int)(rng() % n), 1 + (int)(rng() % 1000)});
+        }
+    }
+    cout << "Graph: " << n << " vertices, " << (long long)n * degree << " directed edges" << endl;
+
+    Result lazy = dijkstraLazy(adj, 0);
+    Result indexed = dijkstraAddressable<IndexedHeap<long long, 4, greater<long long>>>(adj, 0);
+    Result pairing = dijkstraAddressable<PairingHeap<long long, greater<long long>>>(adj, 0);
+
+    report("lazy", lazy);
+    report("indexed", indexed);
+    report("pairing", pairing);
+
+    bool same = lazy.dist == indexed.dist && lazy.dist == pairing.dist;
+    cout << "Distances agree: " << (same ? "yes" : "NO") << endl;
+    return same ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <thread>
+#include <cstdlib>
+#include <stdexcept>
+#include "csr_graph.h"
+#include "parallel_bfs.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Direction-optimizing BFS on a random undirected graph with 1, 2, 4, ...
+// threads. Prints the per-level breakdown (frontier size, direction, time) for
+// every thread count and checks the distances against a plain serial BFS.
+//
+// Usage: ./parallelBfsBenchmark [vertices] [averageDegree] [maxThreads]
+//        (default 1000000 16 hardware_concurrency)
+
+vector<int> serialDistances(const CsrGraph &g, int source)
+{
+    vector<int> distance(g.numVertices(), -1);
+    vector<int> queue(1, source);
+    distance[source] = 0;
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        int u = queue[head];
+        for (int v : g.neighborsOf(u))
+        {
+            if (distance[v] < 0)
+            {
+                distance[v] = distance[u] + 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    return distance;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int degree = argc > 2 ? atoi(argv[2]) : 16;
+    unsigned maxThreads = argc > 3 ? atoi(argv[3]) : thread::hardware_concurrency();
+    if (maxThreads == 0)
+    {
+        maxThreads = 1;
+    }
+
+    mt19937 rng(9);
+    vector<CsrGraph::Edge> edges((size_t)n * degree / 2);
+    for (CsrGraph::Edge &e : edges)
+    {
+        e = {(int)(rng() % n), (int)(rng() % n), 0};
+    }
+    CsrGraph g = CsrGraph::fromEdges(n, edges);
+    cout << "Graph: " << n << " vertices, " << g.numArcs() << " arcs" << endl;
+
+    vector<int> expected;
+    double serialSeconds = timeIt([&]()
+                                  { expected = serialDistances(g, 0); });
+    report("serial top-down BFS", {{serialSeconds * 1e3, "ms", 3}}, 24);
+
+    bool ok = true;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        BfsResult result;
+        double seconds = timeIt([&]()
+                                { result = directionOptimizingBfs(g, 0, threads); });
+
+        cout << endl;
+        benchSection(to_string(threads) + " thread(s)");
+        report("  total", {{seconds * 1e3, "ms", 3}, {g.numArcs() / seconds / 1e6, "M arcs/s"}}, 24);
+        for (const BfsLevel &level : result.levels)
+        {
+            report("  level " + to_string(level.depth) + (level.bottomUp ? " bottom-up" : " top-down"),
+                   {{(double)level.frontier, "vertices", 0}, {level.seconds * 1e3, "ms", 3}}, 24);
+        }
+        ok = ok && result.distance == expected;
+    }
+    bool rejected = false;
+    try
+    {
+        directionOptimizingBfs(g, n);
+    }
+    catch (const out_of_range &)
+    {
+        rejected = true;
+    }
+    cout << endl
+         << "Distances match serial BFS: " << (ok ? "yes" : "NO") << endl
+         << "Out-of-range source rejected: " << (rejected ? "yes" : "NO") << endl;
+    return ok && rejected ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "csr_graph.h"
+
+// Level-synchronous, direction-optimizing BFS (Beamer, Asanovic, Patterson).
+//
+// Each level is expanded either
+//   top-down:  every frontier vertex claims its unvisited neighbours with an
+//              atomic fetch_or on the visited bitmap, or
+//   bottom-up: every unvisited vertex scans its neighbours until it finds one
+//              in the frontier bitmap, then stops early.
+// Top-down is cheap while the frontier is small; bottom-up wins once the
+// frontier touches a large share of the remaining edges, because most of
+// those edges would only hit already visited vertices. The switch uses the
+// paper's heuristics: go bottom-up when the frontier's edge count exceeds
+// (unexplored edges) / alpha, go back top-down when the frontier shrinks
+// below n / beta.
+//
+// The graph must be symmetric (CsrGraph::fromEdges with undirected = true):
+// bottom-up looks for parents among a vertex's neighbours.
+//
+// The worker threads are started once per search and meet at a barrier
+// before and after every level, so on high-diameter graphs the per-level
+// timings measure the level, not thread creation.
+struct BfsLevel
+{
+    int depth;
+    std::size_t frontier;
+    bool bottomUp;
+    double seconds;
+};
+
+struct BfsResult
+{
+    std::vector<int> distance; // -1 when unreachable
+    std::vector<int> parent;   // -1 for the source and unreachable vertices
+    std::vector<BfsLevel> levels;
+};
+
+namespace bfs_detail
+{
+    // Reusable barrier for a fixed number of threads.
+    class Barrier
+    {
+        std::mutex lock;
+        std::condition_variable released;
+        const unsigned parties;
+        unsigned waiting = 0;
+        unsigned generation = 0;
+
+    public:
+        explicit Barrier(unsigned threads) : parties(threads) {}
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            unsigned arrived = generation;
+            if (++waiting == parties)
+            {
+                waiting = 0;
+                ++generation;
+                released.notify_all();
+                return;
+            }
+            released.wait(guard, [&]()
+                          { return generation != arrived; });
+        }
+    };
+
+    // threads - 1 workers plus the calling thread. run(body) calls body(t)
+    // on every thread t and returns when all are done; the workers stay
+    // parked at the barrier in between.
+    class LevelTeam
+    {
+        Barrier barrier;
+        std::vector<std::thread> workers;
+        const void *body = nullptr;
+        void (*call)(const void *, unsigned) = nullptr;
+        bool done = false;
+
+    public:
+        explicit LevelTeam(unsigned threads) : barrier(threads)
+        {
+            for (unsigned t = 1; t < threads; ++t)
+            {
+                workers.emplace_back([this, t]()
+                                     {
+                    for (;;)
+                    {
+                        barrier.wait();
+                        if (done)
+                            return;
+                        call(body, t);
+                        barrier.wait();
+                    } });
+            }
+        }
+
+        LevelTeam(const LevelTeam &) = delete;
+        LevelTeam &operator=(const LevelTeam &) = delete;
+
+        ~LevelTeam()
+        {
+            done = true;
+            barrier.wait();
+            for (std::thread &worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        template <typename Function>
+        void run(const Function &function)
+        {
+            body = &function;
+            call = [](const void *f, unsigned t)
+            { (*static_cast<const Function *>(f))(t); };
+            barrier.wait();
+            function(0);
+            barrier.wait();
+        }
+    };
+
+    inline bool testBit(const std::vector<std::uint64_t> &bits, int v)
+    {
+        return (bits[v >> 6] >> (v & 63)) & 1;
+    }
+}
+
+inline BfsResult directionOptimizingBfs(const CsrGraph &g, int source,
+                                        unsigned threads = std::thread::hardware_concurrency(),
+                                        double alpha = 15, double beta = 18)
+{
+    using bfs_detail::testBit;
+    const int n = g.numVertices();
+    const std::size_t words = ((std::size_t)n + 63) / 64;
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+
+    if (source < 0 || source >= n)
+    {
+        throw std::out_of_range("directionOptimizingBfs: source out of range");
+    }
+
+    BfsResult result;
+    result.distance.assign(n, -1);
+    result.parent.assign(n, -1);
+
+    std::vector<std::atomic<std::uint64_t>> visited(words);
+    for (std::atomic<std::uint64_t> &word : visited)
+    {
+        word.store(0, std::memory_order_relaxed);
+    }
+    std::vector<std::uint64_t> frontierBits(words), nextBits(words);
+    std::vector<int> frontier(1, source);
+    std::vector<std::vector<int>> localNext(threads);
+    std::vector<std::size_t> localCount(threads), localEdges(threads);
+
+    visited[source >> 6].store(1ull << (source & 63), std::memory_order_relaxed);
+    result.distance[source] = 0;
+    std::size_t frontierSize = 1;
+    std::size_t frontierEdges = g.degree(source);
+    std::size_t unexploredEdges = g.numArcs() - frontierEdges;
+    bool bottomUp = false;
+    bfs_detail::LevelTeam team(threads);
+
+    for (int depth = 0; frontierSize > 0; ++depth)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        bool wasBottomUp = bottomUp;
+        if (!bottomUp && frontierEdges > unexploredEdges / alpha)
+        {
+            bottomUp = true;
+        }
+        else if (bottomUp && frontierSize < n / beta)
+        {
+            bottomUp = false;
+        }
+        if (bottomUp && !wasBottomUp)
+        {
+            std::fill(frontierBits.begin(), frontierBits.end(), 0);
+            for (int v : frontier)
+            {
+                frontierBits[v >> 6] |= 1ull << (v & 63);
+            }
+        }
+        else if (!bottomUp && wasBottomUp)
+        {
+            frontier.clear();
+            for (std::size_t w = 0; w < words; ++w)
+            {
+                for (std::uint64_t bits = frontierBits[w]; bits; bits &= bits - 1)
+                {
+                    frontier.push_back((int)(w * 64 + __builtin_ctzll(bits)));
+                }
+            }
+        }
+
+        if (bottomUp)
+        {
+            // Threads own whole 64-vertex words, so no bit is shared.
+            team.run([&](unsigned t)
+                     {
+                std::size_t count = 0, edges = 0;
+                for (std::size_t w = words * t / threads; w < words * (t + 1) / threads; ++w)
+                {
+                    std::uint64_t seen = visited[w].load(std::memory_order_relaxed);
+                    std::uint64_t found = 0;
+                    for (int bit = 0; bit < 64; ++bit)
+                    {
+                        int v = (int)(w * 64 + bit);
+                        if (v >= n)
+                            break;
+                        if ((seen >> bit) & 1)
+                            continue;
+                        for (int u : g.neighborsOf(v))
+                        {
+                            if (testBit(frontierBits, u))
+                            {
+                                result.parent[v] = u;
+                                result.distance[v] = depth + 1;
+                                found |= 1ull << bit;
+                                ++count;
+                                edges += g.degree(v);
+                                break;
+                            }
+                        }
+                    }
+                    nextBits[w] = found;
+                    visited[w].store(seen | found, std::memory_order_relaxed);
+                }
+                localCount[t] = count;
+                localEdges[t] = edges; });
+            frontierBits.swap(nextBits);
+        }
+        else
+        {
+            team.run([&](unsigned t)
+                     {
+                std::vector<int> &next = localNext[t];
+                next.clear();
+                std::size_t edges = 0;
+                for (std::size_t i = frontier.size() * t / threads; i < frontier.size() * (t + 1) / threads; ++i)
+                {
+                    int u = frontier[i];
+                    for (int v : g.neighborsOf(u))
+                    {
+                        std::atomic<std::uint64_t> &word = visited[v >> 6];
+                        std::uint64_t mask = 1ull << (v & 63);
+                        if (word.load(std::memory_order_relaxed) & mask)
+                            continue;
+                        if (word.fetch_or(mask, std::memory_order_relaxed) & mask)
+                            continue;
+                        result.parent[v] = u;
+                        result.distance[v] = depth + 1;
+                        next.push_back(v);
+                        edges += g.degree(v);
+                    }
+                }
+                localCount[t] = next.size();
+                localEdges[t] = edges; });
+            frontier.clear();
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                frontier.insert(frontier.end(), localNext[t].begin(), localNext[t].end());
+            }
+        }
+
+        std::size_t levelSize = frontierSize;
+        frontierSize = 0;
+        frontierEdges = 0;
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            frontierSize += localCount[t];
+            frontierEdges += localEdges[t];
+        }
+        unexploredEdges -= std::min(unexploredEdges, frontierEdges);
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.levels.push_back(BfsLevel{depth, levelSize, bottomUp, seconds});
+    }
+    return result;
+}
+
+#endif // PARALLEL_BFS_H
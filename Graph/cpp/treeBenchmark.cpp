@@ -0,0 +1,161 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <random>
+#include <cstdlib>
+#include "arena_tree.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Builds the same random tree (every node's parent is a random earlier node)
+// as the pointer TreeNode tree of the original treeBfs.cpp and as ArenaTree,
+// then times level-order traversal of both, the BFS relayout, and traversal
+// of the relaid-out arena. The visit order of each traversal is recorded in
+// an untimed pass and compared value by value with the pointer tree's BFS.
+//
+// Usage: ./treeBenchmark [nodes] [rounds]   (default 1000000 5)
+
+struct TreeNode
+{
+    int data;
+    vector<TreeNode *> children;
+    TreeNode(int val) : data(val) {}
+};
+
+void freeTree(TreeNode *root)
+{
+    vector<TreeNode *> stack(1, root);
+    while (!stack.empty())
+    {
+        TreeNode *node = stack.back();
+        stack.pop_back();
+        stack.insert(stack.end(), node->children.begin(), node->children.end());
+        delete node;
+    }
+}
+
+void report(const string &label, size_t n, double seconds)
+{
+    report(label, {{seconds * 1e9 / n, "ns/op"}}, 32);
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 5;
+
+    mt19937 rng(17);
+    vector<int> parentOf(n, -1);
+    for (int i = 1; i < n; i++)
+    {
+        parentOf[i] = rng() % i;
+    }
+
+    vector<TreeNode *> pointers(n);
+    TreeNode *root = nullptr;
+    report("build pointer tree", n, timeIt([&]()
+                                           {
+        root = pointers[0] = new TreeNode(0);
+        for (int i = 1; i < n; i++)
+        {
+            pointers[i] = new TreeNode(i);
+            pointers[parentOf[i]]->children.push_back(pointers[i]);
+        } }));
+
+    ArenaTree<int> arena(0);
+    report("build ArenaTree", n, timeIt([&]()
+                                        {
+        arena.reserve(n);
+        for (int i = 1; i < n; i++)
+        {
+            arena.addChild(parentOf[i], i);
+        } }));
+
+    long long pointerSum = 0, arenaSum = 0, laidOutSum = 0;
+    report("BFS pointer tree", (size_t)n * rounds, timeIt([&]()
+                                                          {
+        queue<TreeNode *> q;
+        for (int r = 0; r < rounds; r++)
+        {
+            q.push(root);
+            while (!q.empty())
+            {
+                TreeNode *current = q.front();
+                q.pop();
+                pointerSum += current->data;
+                for (TreeNode *child : current->children)
+                {
+                    q.push(child);
+                }
+            }
+        } }));
+
+    report("BFS ArenaTree", (size_t)n * rounds, timeIt([&]()
+                                                       {
+        for (int r = 0; r < rounds; r++)
+        {
+            arena.levelOrder([&](ArenaTree<int>::NodeId id)
+                             { arenaSum += arena.value(id); });
+        } }));
+
+    // Untimed passes that record the value sequence of each traversal.
+    vector<int> pointerOrder, arenaOrder, laidOutOrder;
+    pointerOrder.reserve(n);
+    {
+        queue<TreeNode *> q;
+        q.push(root);
+        while (!q.empty())
+        {
+            TreeNode *current = q.front();
+            q.pop();
+            pointerOrder.push_back(current->data);
+            for (TreeNode *child : current->children)
+            {
+                q.push(child);
+            }
+        }
+    }
+    arenaOrder.reserve(n);
+    arena.levelOrder([&](ArenaTree<int>::NodeId id)
+                     { arenaOrder.push_back(arena.value(id)); });
+
+    report("relayoutBfs", n, timeIt([&]()
+                                    { arena.relayoutBfs(); }));
+
+    report("BFS ArenaTree (BFS layout)", (size_t)n * rounds, timeIt([&]()
+                                                                    {
+        for (int r = 0; r < rounds; r++)
+        {
+            arena.levelOrder([&](ArenaTree<int>::NodeId id)
+                             { laidOutSum += arena.value(id); });
+        } }));
+
+    // The relaid-out levelOrder() is a scan of the node array, so also walk
+    // its child / sibling links and check every parent link.
+    laidOutOrder.reserve(n);
+    arena.levelOrder([&](ArenaTree<int>::NodeId id)
+                     { laidOutOrder.push_back(arena.value(id)); });
+    vector<int> linkedOrder;
+    vector<ArenaTree<int>::NodeId> frontier(1, arena.root());
+    bool parentsKept = arena.parent(arena.root()) == ArenaTree<int>::none;
+    for (size_t head = 0; head < frontier.size(); head++)
+    {
+        ArenaTree<int>::NodeId id = frontier[head];
+        linkedOrder.push_back(arena.value(id));
+        arena.forEachChild(id, [&](ArenaTree<int>::NodeId child)
+                           {
+            parentsKept = parentsKept && arena.parent(child) == id && parentOf[arena.value(child)] == arena.value(id);
+            frontier.push_back(child); });
+    }
+
+    report("free pointer tree", n, timeIt([&]()
+                                          { freeTree(root); }));
+
+    bool same = pointerSum == arenaSum && arenaSum == laidOutSum && (int)pointerOrder.size() == n &&
+                arenaOrder == pointerOrder && laidOutOrder == pointerOrder && linkedOrder == pointerOrder &&
+                parentsKept && arena.inBfsLayout();
+    report("ArenaTree memory", {{arena.memoryBytes() / 1048576.0, "MiB"}}, 32);
+    cout << "Traversals agree: " << (same ? "yes" : "NO") << endl;
+    return same ? 0 : 1;
+}
@@ -1,52 +1,34 @@
 #include <iostream>
 #include <vector>
-#include <queue>
+#include "arena_tree.h"
 
 using namespace std;
 
-class TreeNode
+// The tree keeps all nodes in one arena (see arena_tree.h): children are
+// linked by index, nothing is allocated per node and everything is released
+// together when the tree goes out of scope.
+class Tree
 {
 public:
-    int data;
-    vector<TreeNode *> children;
-    TreeNode(int val)
-    {
-        data = val;
-    }
-    void addChild(TreeNode *child)
+    typedef ArenaTree<int>::NodeId NodeId;
+    ArenaTree<int> nodes;
+
+    Tree(int rootVal) : nodes(rootVal) {}
+
+    NodeId root() const
     {
-        children.push_back(child);
+        return nodes.root();
     }
-};
 
-class Tree
-{
-public:
-    TreeNode *root;
-    Tree(int rootVal)
+    NodeId addChild(NodeId parent, int val)
     {
-        root = new TreeNode(rootVal);
+        return nodes.addChild(parent, val);
     }
 
-    void BFS(TreeNode *start)
+    void BFS()
     {
-        if (start == nullptr)
-            return;
-        queue<TreeNode *> q;
-        q.push(start);
-
-        while (!q.empty())
-        {
-            TreeNode *current = q.front();
-            q.pop();
-
-            cout << current->data << " ";
-
-            for (TreeNode *child : current->children)
-            {
-                q.push(child);
-            }
-        }
+        nodes.levelOrder([this](NodeId id)
+                         { cout << nodes.value(id) << " "; });
         cout << endl;
     }
 };
@@ -55,27 +37,27 @@ int main()
 {
     Tree tree(1);
 
-    TreeNode *root = tree.root;
-    TreeNode *child1 = new TreeNode(2);
-    TreeNode *child2 = new TreeNode(3);
-    TreeNode *child3 = new TreeNode(4);
+    Tree::NodeId root = tree.root();
+    Tree::NodeId child1 = tree.addChild(root, 2);
+    Tree::NodeId child2 = tree.addChild(root, 3);
+    tree.addChild(root, 4);
 
-    root->addChild(child1);
-    root->addChild(child2);
-    root->addChild(child3);
+    tree.addChild(child1, 5);
+    tree.addChild(child1, 6);
 
-    TreeNode *child11 = new TreeNode(5);
-    TreeNode *child12 = new TreeNode(6);
-
-    child1->addChild(child11);
-    child1->addChild(child12);
-
-    TreeNode *child21 = new TreeNode(7);
-
-    child2->addChild(child21);
+    tree.addChild(child2, 7);
 
     cout << "BFS traversal of the tree: ";
 
-    tree.BFS(root);
+    tree.BFS();
+
+    // Children added out of level order: BFS falls back to the queue until
+    // the arena is relaid out.
+    tree.addChild(root, 8);
+    cout << "After adding 8 under the root: ";
+    tree.BFS();
+    tree.nodes.relayoutBfs();
+    cout << "After relayout (sequential scan): ";
+    tree.BFS();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <cstdint>
+#include "concurrent_hash_map.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Throughput of ConcurrentHashMap as the thread count doubles from 1 to
+// maxThreads (default: all hardware threads), against the same map with a
+// single shard, i.e. one reader-writer lock around one FlatHashMap. The map
+// is prefilled with `keys` entries; every thread then runs opsPerThread
+// operations on random keys from twice that range (so half the finds miss):
+//   read-heavy     95% find, 5% insertOrAssign
+//   write-heavy    50% find, 50% insertOrAssign
+//   compute        computeIfAbsent, then update() on the result's key
+//
+// Usage: ./concurrentHashMapBenchmark [maxThreads] [opsPerThread] [keys]
+//        (default hardware threads, 1000000, 1000000)
+
+enum Workload
+{
+    READ_HEAVY,
+    WRITE_HEAVY,
+    COMPUTE
+};
+
+double run(size_t shards, Workload workload, unsigned threads, size_t opsPerThread, size_t keys)
+{
+    ConcurrentHashMap<uint64_t, uint64_t> map(shards);
+    map.reserve(2 * keys);
+    for (uint64_t k = 0; k < keys; k++)
+        map.insert(2 * k, k);
+
+    atomic<bool> go(false);
+    atomic<uint64_t> sink(0);
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            uint64_t state = 0x9E3779B97F4A7C15ull * (t + 1), found = 0, value = 0;
+            while (!go.load())
+                this_thread::yield();
+            for (size_t i = 0; i < opsPerThread; i++)
+            {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                uint64_t key = state % (2 * keys);
+                unsigned roll = (unsigned)(state >> 56) % 100;
+                if (workload == COMPUTE)
+                {
+                    found += map.computeIfAbsent(key, [](uint64_t k)
+                                                 { return k; });
+                    map.update(key, [](uint64_t &v)
+                               { v++; });
+                }
+                else if (roll < (workload == READ_HEAVY ? 95u : 50u))
+                    found += map.find(key, value);
+                else
+                    map.insertOrAssign(key, i);
+            }
+            sink += found; });
+    }
+    double seconds = timeIt([&]()
+                            {
+        go.store(true);
+        for (thread &worker : workers)
+            worker.join(); });
+    return threads * opsPerThread / seconds;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned hardware = max(1u, thread::hardware_concurrency());
+    unsigned maxThreads = argc > 1 ? atoi(argv[1]) : hardware;
+    size_t opsPerThread = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1000000;
+    size_t keys = argc > 3 ? strtoull(argv[3], nullptr, 10) : 1000000;
+
+    const char *names[] = {"read-heavy", "write-heavy", "compute"};
+    for (unsigned threads = 1;; threads = min(threads * 2, maxThreads))
+    {
+        benchSection(to_string(threads) + " threads");
+        for (Workload w : {READ_HEAVY, WRITE_HEAVY, COMPUTE})
+        {
+            report("  " + string(names[w]) + " / one lock", {{run(1, w, threads, opsPerThread, keys) / 1e6, "Mops/s"}}, 32);
+            report("  " + string(names[w]) + " / sharded", {{run(0, w, threads, opsPerThread, keys) / 1e6, "Mops/s"}}, 32);
+        }
+        if (threads == maxThreads)
+            break;
+    }
+
+    // Sanity check: concurrent counters built with computeIfAbsent + update.
+    ConcurrentHashMap<uint64_t, uint64_t> counters;
+    vector<thread> workers;
+    for (unsigned t = 0; t < 4; t++)
+        workers.emplace_back([&]()
+                             {
+            for (uint64_t i = 0; i < 100000; i++)
+            {
+                counters.computeIfAbsent(i % 1000, [](uint64_t)
+                                         { return 0; });
+                counters.update(i % 1000, [](uint64_t &v)
+                                { v++; });
+            } });
+    for (thread &worker : workers)
+        worker.join();
+    uint64_t total = 0;
+    counters.forEach([&](uint64_t, uint64_t v)
+                     { total += v; });
+    bool ok = counters.size() == 1000 && total == 400000;
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
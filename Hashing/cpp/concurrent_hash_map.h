@@ -0,0 +1,210 @@
+#ifndef CONCURRENT_HASH_MAP_H
+#define CONCURRENT_HASH_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include "flat_hash_map.h"
+
+// Thread-safe hash map made of independently locked shards.
+//
+// Each shard is a FlatHashMap (the table behind CustomHashTable) with its own
+// reader-writer lock, on its own cache line. A key's shard comes from high
+// bits of its hash, which the shard tables do not use for their own probing,
+// so threads touching different keys almost never meet on the same lock and
+// readers of one shard run in parallel.
+//
+// No reference into the map ever leaves a lock: find() copies the value out,
+// and read-modify-write goes through insertOrAssign / computeIfAbsent /
+// update, each of which is atomic with respect to all other operations on
+// the same key. size() and forEach() lock one shard at a time, so they are
+// not a snapshot of the whole map while writers are running.
+template <typename K, typename V, typename Hash = DefaultHash<K>, typename KeyEqual = DefaultEqual<K>>
+class ConcurrentHashMap
+{
+private:
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex lock;
+        FlatHashMap<K, V, Hash, KeyEqual> table;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    std::size_t shardMask;
+    Hash hasher;
+
+    template <typename Q>
+    Shard &shardOf(const Q &key) const
+    {
+        std::uint64_t h = (std::uint64_t)hasher(key);
+        if (!HashIsAvalanching<Hash>::value)
+        {
+            h = hash_detail::mix(h, 0x9E3779B97F4A7C15ull);
+        }
+        return shards[(std::size_t)(h >> 40) & shardMask];
+    }
+
+public:
+    // shardCount is rounded up to a power of two; 0 picks 4 per hardware
+    // thread.
+    explicit ConcurrentHashMap(std::size_t shardCount = 0, const Hash &hash = Hash(),
+                               const KeyEqual &keyEqual = KeyEqual())
+        : hasher(hash)
+    {
+        if (shardCount == 0)
+        {
+            shardCount = 4 * std::max(1u, std::thread::hardware_concurrency());
+        }
+        std::size_t count = 1;
+        while (count < shardCount && count < ((std::size_t)1 << 24))
+        {
+            count *= 2;
+        }
+        shards.reset(new Shard[count]);
+        shardMask = count - 1;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            shards[i].table = FlatHashMap<K, V, Hash, KeyEqual>(0, hash, keyEqual);
+        }
+    }
+
+    std::size_t shardCount() const { return shardMask + 1; }
+
+    // Spreads room for `elements` entries over the shards.
+    void reserve(std::size_t elements)
+    {
+        for (std::size_t i = 0; i <= shardMask; ++i)
+        {
+            std::unique_lock<std::shared_mutex> guard(shards[i].lock);
+            shards[i].table.reserve(elements / (shardMask + 1) + 1);
+        }
+    }
+
+    // Inserts key -> value unless the key exists. Returns true if inserted.
+    bool insert(const K &key, const V &value)
+    {
+        Shard &shard = shardOf(key);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        return shard.table.insert(key, value);
+    }
+
+    // Inserts or overwrites. Returns true if the key was new.
+    template <typename VArg>
+    bool insertOrAssign(const K &key, VArg &&value)
+    {
+        Shard &shard = shardOf(key);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        return shard.table.insertOrAssign(key, std::forward<VArg>(value));
+    }
+
+    // Returns the value of key, first storing make(key) if it is absent.
+    // make runs at most once per absent key, under the shard's write lock,
+    // so it should be cheap and must not touch this map. Present keys only
+    // take the read lock.
+    template <typename Make>
+    V computeIfAbsent(const K &key, Make make)
+    {
+        Shard &shard = shardOf(key);
+        {
+            std::shared_lock<std::shared_mutex> guard(shard.lock);
+            if (const V *found = shard.table.find(key))
+            {
+                return *found;
+            }
+        }
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        if (const V *found = shard.table.find(key))
+        {
+            return *found;
+        }
+        V value = make(key);
+        shard.table.insert(key, value);
+        return value;
+    }
+
+    // Calls modify(V&) on the value of key under the write lock. Returns false
+    // if the key is absent.
+    template <typename Modify>
+    bool update(const K &key, Modify modify)
+    {
+        Shard &shard = shardOf(key);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        V *found = shard.table.find(key);
+        if (found == nullptr)
+        {
+            return false;
+        }
+        modify(*found);
+        return true;
+    }
+
+    // Copies the value of key into value. Returns false if absent.
+    template <typename Q>
+    bool find(const Q &key, V &value) const
+    {
+        Shard &shard = shardOf(key);
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        const V *found = shard.table.find(key);
+        if (found == nullptr)
+        {
+            return false;
+        }
+        value = *found;
+        return true;
+    }
+
+    template <typename Q>
+    bool contains(const Q &key) const
+    {
+        Shard &shard = shardOf(key);
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        return shard.table.contains(key);
+    }
+
+    template <typename Q>
+    bool erase(const Q &key)
+    {
+        Shard &shard = shardOf(key);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        return shard.table.erase(key);
+    }
+
+    std::size_t size() const
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i <= shardMask; ++i)
+        {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            total += shards[i].table.size();
+        }
+        return total;
+    }
+
+    void clear()
+    {
+        for (std::size_t i = 0; i <= shardMask; ++i)
+        {
+            std::unique_lock<std::shared_mutex> guard(shards[i].lock);
+            shards[i].table.clear();
+        }
+    }
+
+    // Calls visit(key, value) for every entry, one shard at a time under its
+    // read lock. visit must not call back into the map.
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (std::size_t i = 0; i <= shardMask; ++i)
+        {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            shards[i].table.forEach(visit);
+        }
+    }
+};
+
+#endif // CONCURRENT_HASH_MAP_H
@@ -1,109 +1,94 @@
 #include <iostream>
-#include <list>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstdio>
+#include "hash_policies.h"
+#include "incremental_hash_map.h"
+#include "hash_snapshot.h"
 
 using namespace std;
 
-template <typename K, typename V>
-struct KeyValuePair
-{
-    K key;
-    V value;
-    KeyValuePair(K k, V v) : key(k), value(v) {}
-};
-
-template <typename K, typename V>
+// CustomHashTable used to be a vector<list<KeyValuePair>> indexed by
+// key % capacity: one list node allocation per insert and a pointer chase per
+// probe. It now stores its pairs inline in a FlatHashMap (open addressing
+// with 16-wide control-byte groups, see flat_hash_map.h), so any hashable key
+// works, not only integers, and the interface gains erase and reserve.
+//
+// Growth is incremental: each insert / erase moves at most resizeStep slots
+// (512 by default) of the old table into the doubled one (see
+// incremental_hash_map.h), which removes the multi-millisecond insert that
+// used to rehash everything. resizeStep = 0 restores stop-the-world growth.
+//
+// Hash is a policy from hash_policies.h: by default a multiply-shift mixer
+// for integers and a wyhash-style byte hash for strings. Pass a policy built
+// with randomHashSeed() when keys may come from an attacker.
+template <typename K, typename V, typename Hash = DefaultHash<K>, typename KeyEqual = DefaultEqual<K>>
 class CustomHashTable
 {
 private:
-    vector<list<KeyValuePair<K, V>>> table;
-    int size;
-    int capacity;
-    int hash(K key)
-    {
-        return key % capacity;
-    }
-    void resize()
-    {
-        int newCapacity = capacity * 2;
-        vector<list<KeyValuePair<K, V>>> newTable(newCapacity);
-        for (int i = 0; i < capacity; i++)
-        {
-            for (auto &kv : table[i])
-            {
-                int index = kv.key % newCapacity;
-                newTable[index].push_back(kv);
-            }
-        }
+    IncrementalHashMap<K, V, Hash, KeyEqual> table;
+
+public:
+    CustomHashTable(int intitialCapacity = 10, int resizeStep = 512, const Hash &hash = Hash())
+        : table(resizeStep, intitialCapacity, hash) {}
 
-        table = move(newTable);
-        capacity = newCapacity;
+    void setResizeStep(int resizeStep)
+    {
+        table.setMigrationStep(resizeStep);
     }
 
-public:
-    CustomHashTable(int intitialCapacity = 10)
+    // Inserts key -> value, overwriting the value of an existing key.
+    void insert(const K &key, const V &value)
     {
-        capacity = intitialCapacity;
-        table.resize(capacity);
-        size = 0;
+        table.insertOrAssign(key, value);
     }
 
-    void insert(K key, V value)
+    // Accepts any type the hash and equality accept (e.g. string_view for
+    // string keys with the default string policy).
+    template <typename Q>
+    bool search(const Q &key, V &value) const
     {
-        if (size >= .7 * capacity)
+        const V *found = table.find(key);
+        if (found == nullptr)
         {
-            resize();
+            return false;
         }
+        value = *found;
+        return true;
+    }
 
-        int index = hash(key);
-        for (auto &kv : table[index])
-        {
-            if (kv.key == key)
-            {
-                kv.value = value;
-                return;
-            }
-        }
+    template <typename Q>
+    bool erase(const Q &key)
+    {
+        return table.erase(key);
+    }
 
-        table[index].push_back(KeyValuePair<K, V>(key, value));
-        size++;
+    void reserve(int count)
+    {
+        table.reserve(count);
     }
 
-    bool search(K key, V &value)
+    int getSize() const
     {
-        int index = hash(key);
-        for (auto &kv : table[index])
-        {
-            if (kv.key == key)
-            {
-                value = key.value;
-                return true;
-            }
-        }
-        return false;
+        return (int)table.size();
     }
-    int getSize()
+
+    // Writes the table to a file that MappedHashTable<K, V, Hash, KeyEqual>
+    // can open and query in place (see hash_snapshot.h).
+    void saveSnapshot(const string &path)
     {
-        return size;
+        table.finishMigration();
+        writeSnapshot(table.table(), path);
     }
 
-    void printTable()
+    void printTable() const
     {
-        for (int i = 0; i < capacity; i++)
-        {
-            if (!table[i].empty())
-            {
-                cout << "Bucket " << i << ": ";
-                for (auto &kv : table[i])
-                {
-                    cout << "(" << kv.key << ", " << kv.value << ")";
-                }
-                cout << endl;
-            }
-        }
+        table.forEach([](const K &key, const V &value)
+                      { cout << "(" << key << ", " << value << ")" << endl; });
     }
 };
+
 int main()
 {
     CustomHashTable<int, string> hashTable;
@@ -113,5 +98,46 @@ int main()
     hashTable.insert(3, "Three");
     hashTable.insert(12, "Twelve");
     hashTable.printTable();
+
+    string value;
+    if (hashTable.search(12, value))
+    {
+        cout << "Found 12: " << value << endl;
+    }
+    hashTable.erase(2);
+    cout << "After erasing 2, size = " << hashTable.getSize()
+         << ", 2 present: " << (hashTable.search(2, value) ? "yes" : "no") << endl;
+
+    CustomHashTable<int, int> incremental(10, 16);
+    CustomHashTable<int, int> stopTheWorld(10, 0);
+    for (int i = 0; i < 1000; i++)
+    {
+        incremental.insert(i, i * i);
+        stopTheWorld.insert(i, i * i);
+    }
+    int square = 0, same = 0;
+    incremental.search(999, square);
+    stopTheWorld.search(999, same);
+    cout << "Incremental table: size = " << incremental.getSize() << ", 999^2 = " << square
+         << ", stop-the-world agrees: " << (square == same && stopTheWorld.getSize() == 1000 ? "yes" : "NO") << endl;
+
+    hashTable.saveSnapshot("hashTable.snapshot");
+    MappedHashTable<int, string> mapped("hashTable.snapshot");
+    string_view name;
+    if (mapped.find(3, name))
+    {
+        cout << "From snapshot (" << mapped.size() << " entries): 3 -> " << name << endl;
+    }
+    remove("hashTable.snapshot");
+
+    // String keys, hashed with a per-table random seed.
+    CustomHashTable<string, int> words(10, 512, StringHash(randomHashSeed()));
+    words.insert("apple", 5);
+    words.insert("banana", 6);
+    int length = 0;
+    if (words.search(string_view("banana"), length))
+    {
+        cout << "banana -> " << length << endl;
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,581 @@
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "hash_policies.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Open-addressing hash map in the style of Swiss tables.
+//
+// Every slot has a one-byte control tag: empty, deleted (tombstone), or the
+// top bit plus the low 7 bits of the key's hash (H2). Slots are grouped by 16; a lookup hashes
+// once, picks a starting group from the remaining bits (H1), and compares the
+// H2 tag against all 16 control bytes of the group at once (one SSE2 compare,
+// or a plain loop elsewhere). Only slots whose tag matches are compared by
+// key, so a miss rarely touches the slot array at all, and a group containing
+// an empty control byte ends the probe. Groups are probed triangularly
+// (g, g+1, g+3, g+6, ...), which visits every group of a power-of-two table.
+//
+// Keys and values are stored inline in one flat array: no allocation per
+// insert. Erasing marks a tombstone only when the group is full (a lookup
+// might have probed past it); tombstones are reclaimed by the next rehash.
+//
+// Hash is a policy from hash_policies.h (DefaultHash<K> picks one per key
+// type) or any hasher; a hash not marked is_avalanching is mixed before use,
+// so weak hashes (std::hash<int> is the identity) still spread over the
+// table. find / contains / erase accept any type Hash and KeyEqual accept,
+// e.g. std::string_view against std::string keys with the default string
+// policy, without a temporary string.
+template <typename K, typename V, typename Hash = DefaultHash<K>, typename KeyEqual = DefaultEqual<K>>
+class FlatHashMap
+{
+public:
+    typedef std::pair<K, V> Slot;
+
+private:
+    static const std::size_t kGroupWidth = 16;
+    // Full slots have the top bit set, so an all-zero control array (fresh
+    // calloc pages) is an empty table and costs nothing until touched.
+    static const std::int8_t kEmpty = 0;
+    static const std::int8_t kDeleted = 1;
+
+    std::int8_t *ctrl = nullptr;
+    Slot *slots = nullptr;
+    std::size_t slotCount = 0; // 0 or a power of two >= kGroupWidth
+    std::size_t count = 0;
+    std::size_t tombstones = 0;
+    Hash hasher;
+    KeyEqual equal;
+
+    // Bitmask of the bytes in a group that satisfy a condition.
+    struct Group
+    {
+#if defined(__SSE2__)
+        __m128i bytes;
+        explicit Group(const std::int8_t *p) : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {}
+        unsigned match(std::int8_t tag) const
+        {
+            return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(tag)));
+        }
+        unsigned matchEmpty() const { return match(kEmpty); }
+        // Empty and deleted are the only non-negative control values.
+        unsigned matchFree() const { return ~(unsigned)_mm_movemask_epi8(bytes) & 0xFFFFu; }
+#else
+        const std::int8_t *p;
+        explicit Group(const std::int8_t *p) : p(p) {}
+        unsigned match(std::int8_t tag) const
+        {
+            unsigned mask = 0;
+            for (unsigned i = 0; i < kGroupWidth; ++i)
+                mask |= (unsigned)(p[i] == tag) << i;
+            return mask;
+        }
+        unsigned matchEmpty() const { return match(kEmpty); }
+        unsigned matchFree() const
+        {
+            unsigned mask = 0;
+            for (unsigned i = 0; i < kGroupWidth; ++i)
+                mask |= (unsigned)(p[i] >= 0) << i;
+            return mask;
+        }
+#endif
+    };
+
+    static std::int8_t tagOf(std::uint64_t h) { return (std::int8_t)(0x80 | (h & 0x7F)); }
+    static bool isFull(std::int8_t c) { return c < 0; }
+
+    static unsigned lowestBit(unsigned mask) { return (unsigned)__builtin_ctz(mask); }
+
+    template <typename Q>
+    std::uint64_t hashOf(const Q &key) const
+    {
+        return hashWith(hasher, key);
+    }
+
+    std::size_t groupMask() const { return slotCount / kGroupWidth - 1; }
+
+    std::size_t growthLimit() const { return slotCount - slotCount / 8; }
+
+    template <typename Q>
+    std::size_t findIndex(const Q &key, std::uint64_t h) const
+    {
+        return probe(ctrl, slotCount, h, [&](std::size_t index)
+                     { return equal(slots[index].first, key); });
+    }
+
+    // First empty or deleted slot on the probe sequence of h.
+    std::size_t findFree(std::uint64_t h) const
+    {
+        std::size_t group = (std::size_t)(h >> 7) & groupMask();
+        for (std::size_t step = 1;; ++step)
+        {
+            unsigned mask = Group(ctrl + group * kGroupWidth).matchFree();
+            if (mask)
+            {
+                return group * kGroupWidth + lowestBit(mask);
+            }
+            group = (group + step) & groupMask();
+        }
+    }
+
+    void allocate(std::size_t newSlotCount)
+    {
+        slotCount = newSlotCount;
+        ctrl = static_cast<std::int8_t *>(std::calloc(slotCount, 1));
+        if (ctrl == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        slots = std::allocator<Slot>().allocate(slotCount);
+        count = 0;
+        tombstones = 0;
+    }
+
+    void release()
+    {
+        if (slotCount == 0)
+        {
+            return;
+        }
+        // Skipping the scan when nothing is left matters to incremental
+        // rehashing, which releases large drained tables mid-insert.
+        for (std::size_t i = 0; count != 0 && i < slotCount; ++i)
+        {
+            if (isFull(ctrl[i]))
+            {
+                slots[i].~Slot();
+                --count;
+            }
+        }
+        std::allocator<Slot>().deallocate(slots, slotCount);
+        std::free(ctrl);
+        ctrl = nullptr;
+        slots = nullptr;
+        slotCount = 0;
+        count = 0;
+        tombstones = 0;
+    }
+
+    void rehash(std::size_t newSlotCount)
+    {
+        std::int8_t *oldCtrl = ctrl;
+        Slot *oldSlots = slots;
+        std::size_t oldSlotCount = slotCount;
+        allocate(newSlotCount);
+        for (std::size_t i = 0; i < oldSlotCount; ++i)
+        {
+            if (isFull(oldCtrl[i]))
+            {
+                std::uint64_t h = hashOf(oldSlots[i].first);
+                std::size_t index = findFree(h);
+                ctrl[index] = tagOf(h);
+                new (slots + index) Slot(std::move(oldSlots[i]));
+                oldSlots[i].~Slot();
+                ++count;
+            }
+        }
+        if (oldSlotCount)
+        {
+            std::allocator<Slot>().deallocate(oldSlots, oldSlotCount);
+            std::free(oldCtrl);
+        }
+    }
+
+    // Rebuilds the table in its own arrays, without tombstones and without
+    // allocating (Abseil's DropDeletesWithoutResize). Every full slot is
+    // first marked deleted, meaning "not placed yet", and every tombstone
+    // empty; then each unplaced entry goes to the first free slot on its
+    // probe sequence. It stays put if that slot is in its own group, moves
+    // if the slot is empty, and swaps with the unplaced entry there
+    // otherwise, which is then placed in turn.
+    void rehashInPlace()
+    {
+        for (std::size_t i = 0; i < slotCount; ++i)
+        {
+            ctrl[i] = isFull(ctrl[i]) ? kDeleted : kEmpty;
+        }
+        for (std::size_t i = 0; i < slotCount;)
+        {
+            if (ctrl[i] != kDeleted)
+            {
+                ++i;
+                continue;
+            }
+            std::uint64_t h = hashOf(slots[i].first);
+            std::size_t target = findFree(h);
+            if (target / kGroupWidth == i / kGroupWidth)
+            {
+                ctrl[i] = tagOf(h);
+                ++i;
+            }
+            else if (ctrl[target] == kEmpty)
+            {
+                new (slots + target) Slot(std::move(slots[i]));
+                slots[i].~Slot();
+                ctrl[target] = tagOf(h);
+                ctrl[i] = kEmpty;
+                ++i;
+            }
+            else
+            {
+                std::swap(slots[i], slots[target]);
+                ctrl[target] = tagOf(h);
+            }
+        }
+        tombstones = 0;
+    }
+
+    static std::size_t slotsFor(std::size_t elements)
+    {
+        std::size_t needed = elements + elements / 7 + 1;
+        std::size_t n = kGroupWidth;
+        while (n < needed)
+        {
+            n *= 2;
+        }
+        return n;
+    }
+
+    // Makes room for one more element before an insert.
+    void prepareInsert()
+    {
+        if (count + tombstones + 1 <= growthLimit())
+        {
+            return;
+        }
+        if (rehashesInPlace())
+        {
+            rehashInPlace();
+        }
+        else
+        {
+            rehash(slotCount ? slotCount * 2 : kGroupWidth);
+        }
+    }
+
+    template <typename KeyArg, typename... Args>
+    std::pair<Slot *, bool> tryEmplace(KeyArg &&key, Args &&...args)
+    {
+        std::uint64_t h = hashOf(key);
+        std::size_t index = findIndex(key, h);
+        if (index != slotCount)
+        {
+            return std::make_pair(slots + index, false);
+        }
+        prepareInsert();
+        index = findFree(h);
+        if (ctrl[index] == kDeleted)
+        {
+            --tombstones;
+        }
+        ctrl[index] = tagOf(h);
+        new (slots + index) Slot(std::piecewise_construct, std::forward_as_tuple(std::forward<KeyArg>(key)),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+        ++count;
+        return std::make_pair(slots + index, true);
+    }
+
+public:
+    // The hash the table uses for key: Hash's value, mixed unless Hash is
+    // marked is_avalanching.
+    template <typename Q>
+    static std::uint64_t hashWith(const Hash &hash, const Q &key)
+    {
+        std::uint64_t h = (std::uint64_t)hash(key);
+        return HashIsAvalanching<Hash>::value ? h : hash_detail::mix(h, 0x9E3779B97F4A7C15ull);
+    }
+
+    // The lookup probe over a control array laid out like this table's:
+    // returns the first slot on h's probe sequence whose tag matches and for
+    // which matches(index) holds, or slotCount. Shared with readers of
+    // saved tables (hash_snapshot.h). The triangular sequence visits every
+    // group once in slotCount / kGroupWidth steps, so the probe stops there
+    // even if a corrupt control array has no empty byte.
+    template <typename Matches>
+    static std::size_t probe(const std::int8_t *ctrl, std::size_t slotCount, std::uint64_t h, Matches matches)
+    {
+        if (slotCount == 0)
+        {
+            return slotCount;
+        }
+        const std::int8_t tag = tagOf(h);
+        const std::size_t mask = slotCount / kGroupWidth - 1;
+        std::size_t group = (std::size_t)(h >> 7) & mask;
+        for (std::size_t step = 1; step <= mask + 1; ++step)
+        {
+            Group g(ctrl + group * kGroupWidth);
+            for (unsigned hits = g.match(tag); hits; hits &= hits - 1)
+            {
+                std::size_t index = group * kGroupWidth + lowestBit(hits);
+                if (matches(index))
+                {
+                    return index;
+                }
+            }
+            if (g.matchEmpty())
+            {
+                return slotCount;
+            }
+            group = (group + step) & mask;
+        }
+        return slotCount;
+    }
+
+    static bool isFullControl(std::int8_t c) { return isFull(c); }
+    static std::int8_t controlTag(std::uint64_t h) { return tagOf(h); }
+
+    FlatHashMap() = default;
+
+    explicit FlatHashMap(std::size_t expected, const Hash &hash = Hash(), const KeyEqual &keyEqual = KeyEqual())
+        : hasher(hash), equal(keyEqual)
+    {
+        reserve(expected);
+    }
+
+    FlatHashMap(const FlatHashMap &other) : hasher(other.hasher), equal(other.equal)
+    {
+        reserve(other.count);
+        other.forEach([this](const K &key, const V &value)
+                      { tryEmplace(key, value); });
+    }
+
+    FlatHashMap(FlatHashMap &&other) noexcept
+        : ctrl(other.ctrl), slots(other.slots), slotCount(other.slotCount), count(other.count),
+          tombstones(other.tombstones), hasher(std::move(other.hasher)), equal(std::move(other.equal))
+    {
+        other.ctrl = nullptr;
+        other.slots = nullptr;
+        other.slotCount = other.count = other.tombstones = 0;
+    }
+
+    FlatHashMap &operator=(FlatHashMap other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~FlatHashMap() { release(); }
+
+    void swap(FlatHashMap &other) noexcept
+    {
+        std::swap(ctrl, other.ctrl);
+        std::swap(slots, other.slots);
+        std::swap(slotCount, other.slotCount);
+        std::swap(count, other.count);
+        std::swap(tombstones, other.tombstones);
+        std::swap(hasher, other.hasher);
+        std::swap(equal, other.equal);
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::size_t capacity() const { return slotCount; }
+    double loadFactor() const { return slotCount ? (double)count / slotCount : 0.0; }
+
+    // Grows the table so that `elements` entries fit without a rehash.
+    void reserve(std::size_t elements)
+    {
+        std::size_t wanted = slotsFor(elements);
+        if (wanted > slotCount)
+        {
+            rehash(wanted);
+        }
+    }
+
+    void clear() { release(); }
+
+    // Inserts key -> value unless the key exists. Returns true if inserted.
+    bool insert(const K &key, const V &value) { return tryEmplace(key, value).second; }
+
+    template <typename KArg, typename VArg>
+    bool emplace(KArg &&key, VArg &&value)
+    {
+        return tryEmplace(std::forward<KArg>(key), std::forward<VArg>(value)).second;
+    }
+
+    // Inserts or overwrites. Returns true if the key was new.
+    template <typename VArg>
+    bool insertOrAssign(const K &key, VArg &&value)
+    {
+        std::pair<Slot *, bool> result = tryEmplace(key, std::forward<VArg>(value));
+        if (!result.second)
+        {
+            result.first->second = std::forward<VArg>(value);
+        }
+        return result.second;
+    }
+
+    V &operator[](const K &key) { return tryEmplace(key).first->second; }
+    V &operator[](K &&key) { return tryEmplace(std::move(key)).first->second; }
+
+    // Lookups take K, or with transparent Hash/KeyEqual any comparable type.
+    template <typename Q>
+    V *find(const Q &key)
+    {
+        std::size_t index = findIndex(key, hashOf(key));
+        return index == slotCount ? nullptr : &slots[index].second;
+    }
+
+    template <typename Q>
+    const V *find(const Q &key) const
+    {
+        std::size_t index = findIndex(key, hashOf(key));
+        return index == slotCount ? nullptr : &slots[index].second;
+    }
+
+    template <typename Q>
+    bool contains(const Q &key) const { return find(key) != nullptr; }
+
+    template <typename Q>
+    bool erase(const Q &key)
+    {
+        std::size_t index = findIndex(key, hashOf(key));
+        if (index == slotCount)
+        {
+            return false;
+        }
+        slots[index].~Slot();
+        --count;
+        std::size_t groupStart = index & ~(kGroupWidth - 1);
+        if (Group(ctrl + groupStart).matchEmpty())
+        {
+            ctrl[index] = kEmpty;
+        }
+        else
+        {
+            ctrl[index] = kDeleted;
+            ++tombstones;
+        }
+        return true;
+    }
+
+    // Calls visit(key, value) for every entry, in slot order.
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (std::size_t i = 0; i < slotCount; ++i)
+        {
+            if (isFull(ctrl[i]))
+            {
+                visit(slots[i].first, slots[i].second);
+            }
+        }
+    }
+
+    template <typename Visit>
+    void forEach(Visit visit)
+    {
+        for (std::size_t i = 0; i < slotCount; ++i)
+        {
+            if (isFull(ctrl[i]))
+            {
+                visit(slots[i].first, slots[i].second);
+            }
+        }
+    }
+
+    // True if the next insert of a new key would rehash the table.
+    bool atGrowthLimit() const { return count + tombstones + 1 > growthLimit(); }
+
+    // True if that rehash would keep the slot count: the table is at its
+    // limit mostly because of tombstones, so it is rebuilt in place,
+    // without allocating, instead of doubled.
+    bool rehashesInPlace() const { return slotCount && count + 1 <= growthLimit() / 2; }
+
+    // Moves the entries of slots [cursor, cursor + slotBudget) out through
+    // sink(key&&, value&&) and returns where to continue (capacity() when
+    // done). Vacated slots become tombstones, so entries not moved yet stay
+    // reachable. Used to rehash incrementally into another table.
+    template <typename Sink>
+    std::size_t migrateOut(std::size_t cursor, std::size_t slotBudget, Sink sink)
+    {
+        std::size_t end = slotBudget < slotCount - cursor ? cursor + slotBudget : slotCount;
+        for (; cursor < end; ++cursor)
+        {
+            if (isFull(ctrl[cursor]))
+            {
+                sink(std::move(slots[cursor].first), std::move(slots[cursor].second));
+                slots[cursor].~Slot();
+                ctrl[cursor] = kDeleted;
+                --count;
+                ++tombstones;
+            }
+        }
+        return cursor;
+    }
+
+    // Hands the whole pages of slots [begin, end) back to the OS and returns
+    // the slot to pass as `begin` next time. The slots must hold no entries,
+    // e.g. the ones migrateOut has passed; lookups only read slots whose
+    // control byte is full, so the table stays usable. Lets a drained table
+    // be freed a piece at a time instead of in one large munmap.
+    std::size_t discardSlots(std::size_t begin, std::size_t end)
+    {
+        static const std::uintptr_t page = (std::uintptr_t)sysconf(_SC_PAGESIZE);
+        std::uintptr_t from = ((std::uintptr_t)(slots + begin) + page - 1) & ~(page - 1);
+        std::uintptr_t to = (std::uintptr_t)(slots + end) & ~(page - 1);
+        if (to <= from)
+        {
+            return begin;
+        }
+        madvise(reinterpret_cast<void *>(from), to - from, MADV_DONTNEED);
+        return (to - (std::uintptr_t)slots) / sizeof(Slot);
+    }
+
+    // histogram[i] = number of keys found in the i-th group of their probe
+    // sequence (0 = home group). Long tails mean a weak or attacked hash.
+    std::vector<std::size_t> probeHistogram() const
+    {
+        std::vector<std::size_t> histogram;
+        for (std::size_t i = 0; i < slotCount; ++i)
+        {
+            if (!isFull(ctrl[i]))
+            {
+                continue;
+            }
+            std::size_t group = (std::size_t)(hashOf(slots[i].first) >> 7) & groupMask();
+            std::size_t probes = 0;
+            for (std::size_t step = 1; group != i / kGroupWidth; ++step)
+            {
+                group = (group + step) & groupMask();
+                ++probes;
+            }
+            if (histogram.size() <= probes)
+            {
+                histogram.resize(probes + 1);
+            }
+            ++histogram[probes];
+        }
+        return histogram;
+    }
+
+    const Hash &hashFunction() const { return hasher; }
+
+    // Raw layout, for writing the table out: capacity() control bytes and
+    // slots; a slot holds an entry iff isFullControl(its control byte).
+    const std::int8_t *controlBytes() const { return ctrl; }
+    const Slot *slotData() const { return slots; }
+
+    std::size_t memoryBytes() const { return slotCount * (sizeof(Slot) + 1); }
+};
+
+template <typename K, typename V, typename H, typename E>
+const std::size_t FlatHashMap<K, V, H, E>::kGroupWidth;
+template <typename K, typename V, typename H, typename E>
+const std::int8_t FlatHashMap<K, V, H, E>::kEmpty;
+template <typename K, typename V, typename H, typename E>
+const std::int8_t FlatHashMap<K, V, H, E>::kDeleted;
+
+#endif // FLAT_HASH_MAP_H
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdlib>
+#include <cstdint>
+#include "flat_hash_map.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Probe-length distribution and throughput of FlatHashMap under different
+// hash policies, on friendly and hostile key sets:
+//   sequential   0, 1, 2, ...
+//   strided      i << 20 (aligned addresses, ids with a shard in the low bits)
+//   high bits    i << 40 (nothing at all in the low 40 bits)
+//   strings      "user:00000001", ... and 64-byte URL-like keys
+// "identity" uses the key itself as the hash and masks it, which is what
+// `key % capacity` with a power-of-two capacity amounts to. "std::hash" is
+// std::hash with the table's fallback mixing. Probes counts the groups a
+// lookup visits beyond the home group: mean, max, and the share of keys
+// not in their home group.
+//
+// Usage: ./hashPolicyBenchmark [keys]   (default 50000)
+
+struct IdentityHash
+{
+    using is_avalanching = void;
+    uint64_t operator()(uint64_t key) const { return key; }
+};
+
+template <typename T>
+struct StdHash
+{
+    size_t operator()(const T &key) const { return hash<T>()(key); }
+};
+
+template <typename K, typename Hash, typename Equal = DefaultEqual<K>>
+bool run(const string &label, const vector<K> &keys, const Hash &hasher = Hash())
+{
+    FlatHashMap<K, uint32_t, Hash, Equal> table(0, hasher);
+    double insertSeconds = timeIt([&]()
+                                  {
+        for (size_t i = 0; i < keys.size(); i++)
+            table.insert(keys[i], (uint32_t)i); });
+    size_t found = 0;
+    double lookupSeconds = timeIt([&]()
+                                  {
+        for (const K &k : keys)
+            found += table.contains(k); });
+
+    vector<size_t> histogram = table.probeHistogram();
+    size_t total = 0, displaced = 0;
+    double sum = 0;
+    for (size_t probes = 0; probes < histogram.size(); probes++)
+    {
+        total += histogram[probes];
+        sum += (double)probes * histogram[probes];
+        if (probes > 0)
+            displaced += histogram[probes];
+    }
+    report(label, {{insertSeconds * 1e9 / keys.size(), "ns/insert", 1}, {lookupSeconds * 1e9 / keys.size(), "ns/lookup", 1}, {sum / total, "probes", 3}, {(double)histogram.size() - 1, "max probes", 0}, {100.0 * displaced / total, "moved %", 1}}, 34);
+    return found == keys.size() && total == keys.size();
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? atol(argv[1]) : 50000;
+    uint64_t seed = randomHashSeed();
+
+    vector<uint64_t> sequential(n), strided(n), highBits(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        sequential[i] = i;
+        strided[i] = (uint64_t)i << 20;
+        highBits[i] = (uint64_t)i << 40;
+    }
+    vector<string> names(n), urls(n);
+    mt19937_64 rng(3);
+    for (size_t i = 0; i < n; i++)
+    {
+        string id = to_string(i);
+        names[i] = "user:" + string(8 - min<size_t>(8, id.size()), '0') + id;
+        urls[i] = "https://example.com/static/assets/v2/images/" + to_string(rng()) + ".png";
+        urls[i].resize(64, '_');
+    }
+
+    bool ok = true;
+    struct IntSet
+    {
+        const char *name;
+        const vector<uint64_t> &keys;
+    };
+    for (const IntSet &set : {IntSet{"sequential", sequential}, IntSet{"strided", strided}, IntSet{"high bits", highBits}})
+    {
+        string name = set.name;
+        ok = run<uint64_t, IdentityHash>(name + " / identity", set.keys) && ok;
+        ok = run<uint64_t, StdHash<uint64_t>>(name + " / std::hash", set.keys) && ok;
+        ok = run<uint64_t, IntegerHash<uint64_t>>(name + " / IntegerHash", set.keys) && ok;
+        ok = run<uint64_t, IntegerHash<uint64_t>>(name + " / IntegerHash seeded", set.keys,
+                                                  IntegerHash<uint64_t>(seed)) &&
+             ok;
+    }
+    struct StringSet
+    {
+        const char *name;
+        const vector<string> &keys;
+    };
+    for (const StringSet &set : {StringSet{"names", names}, StringSet{"urls", urls}})
+    {
+        string name = set.name;
+        ok = run<string, StdHash<string>, equal_to<string>>(name + " / std::hash", set.keys) && ok;
+        ok = run<string, StringHash>(name + " / StringHash", set.keys) && ok;
+        ok = run<string, StringHash>(name + " / StringHash seeded", set.keys, StringHash(seed)) && ok;
+    }
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+#include <iostream>
+#include <list>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <random>
+#include <cstdlib>
+#include "flat_hash_map.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Insert throughput and hit / miss lookup cost of
+//   chained        - the former CustomHashTable: vector<list<pair>>, key % capacity
+//   unordered_map  - std::unordered_map
+//   FlatHashMap    - the open-addressing table behind CustomHashTable now
+// on random 64-bit keys and on short string keys. Misses use keys that were
+// never inserted. Every table must find the same number of hits. Last,
+// insert / erase churn at a steady size, which fills a FlatHashMap with
+// tombstones, must keep its capacity (it is rebuilt in place) and its keys.
+//
+// Usage: ./hashTableBenchmark [keys] [lookups]   (default 1000000 4000000)
+
+// The original separate-chaining table, kept here as the baseline.
+template <typename K, typename V>
+class ChainedHashTable
+{
+    vector<list<pair<K, V>>> table;
+    size_t size = 0;
+    size_t capacity;
+
+    size_t index(const K &key, size_t cap) const { return hash<K>()(key) % cap; }
+
+    void resize()
+    {
+        size_t newCapacity = capacity * 2;
+        vector<list<pair<K, V>>> newTable(newCapacity);
+        for (auto &bucket : table)
+            for (auto &kv : bucket)
+                newTable[index(kv.first, newCapacity)].push_back(kv);
+        table = move(newTable);
+        capacity = newCapacity;
+    }
+
+public:
+    ChainedHashTable(size_t initialCapacity = 10) : table(initialCapacity), capacity(initialCapacity) {}
+
+    void insert(const K &key, const V &value)
+    {
+        if (size >= .7 * capacity)
+            resize();
+        auto &bucket = table[index(key, capacity)];
+        for (auto &kv : bucket)
+            if (kv.first == key)
+            {
+                kv.second = value;
+                return;
+            }
+        bucket.push_back(make_pair(key, value));
+        size++;
+    }
+
+    const V *find(const K &key) const
+    {
+        for (auto &kv : table[index(key, capacity)])
+            if (kv.first == key)
+                return &kv.second;
+        return nullptr;
+    }
+};
+
+void report(const string &label, size_t n, double seconds)
+{
+    report(label, {{seconds * 1e9 / n, "ns/op"}}, 32);
+}
+
+template <typename K>
+struct Workload
+{
+    vector<K> keys;    // inserted
+    vector<K> hits;    // drawn from keys
+    vector<K> misses;  // never inserted
+};
+
+// Inserts, then looks up hits and misses; returns the number of hits found.
+template <typename Table, typename K, typename Insert, typename Find>
+size_t run(const string &name, const Workload<K> &w, Insert insert, Find find)
+{
+    Table table;
+    report(name + " insert", w.keys.size(), timeIt([&]()
+                                                   {
+        for (size_t i = 0; i < w.keys.size(); i++)
+            insert(table, w.keys[i], i); }));
+    size_t found = 0, falseHits = 0;
+    report(name + " lookup hit", w.hits.size(), timeIt([&]()
+                                                       {
+        for (const K &k : w.hits)
+            found += find(table, k); }));
+    report(name + " lookup miss", w.misses.size(), timeIt([&]()
+                                                          {
+        for (const K &k : w.misses)
+            falseHits += find(table, k); }));
+    return falseHits ? 0 : found;
+}
+
+template <typename K>
+bool runAll(const string &title, const Workload<K> &w)
+{
+    benchSection(title);
+    size_t chained = run<ChainedHashTable<K, size_t>>(
+        "  chained", w, [](ChainedHashTable<K, size_t> &t, const K &k, size_t v)
+        { t.insert(k, v); },
+        [](const ChainedHashTable<K, size_t> &t, const K &k)
+        { return t.find(k) != nullptr; });
+    size_t stl = run<unordered_map<K, size_t>>(
+        "  unordered_map", w, [](unordered_map<K, size_t> &t, const K &k, size_t v)
+        { t[k] = v; },
+        [](const unordered_map<K, size_t> &t, const K &k)
+        { return t.find(k) != t.end(); });
+    size_t flat = run<FlatHashMap<K, size_t>>(
+        "  FlatHashMap", w, [](FlatHashMap<K, size_t> &t, const K &k, size_t v)
+        { t.insertOrAssign(k, v); },
+        [](const FlatHashMap<K, size_t> &t, const K &k)
+        { return t.contains(k); });
+    bool ok = chained == w.hits.size() && stl == chained && flat == chained;
+    cout << "  checks: " << (ok ? "ok" : "FAILED") << endl
+         << endl;
+    return ok;
+}
+
+// Keeps `live` keys while inserting and erasing 500 tables' worth of others.
+template <typename K, typename MakeKey>
+bool churnKeepsCapacity(const string &label, MakeKey makeKey)
+{
+    const size_t live = 850; // 2048 slots: below half the growth limit, but
+                             // full enough that erases leave tombstones
+    FlatHashMap<K, size_t> table(1000);
+    for (size_t i = 0; i < live; i++)
+        table.insert(makeKey(i), i);
+    size_t settled = table.capacity();
+    for (size_t k = live; k < live + 500 * settled; k++)
+    {
+        table.insert(makeKey(k), k);
+        table.erase(makeKey(k - live));
+    }
+    size_t end = live + 500 * settled;
+    bool ok = table.size() == live && table.capacity() == settled && !table.contains(makeKey(end - live - 1));
+    for (size_t k = end - live; k < end; k++)
+    {
+        const size_t *value = table.find(makeKey(k));
+        ok = ok && value != nullptr && *value == k;
+    }
+    cout << "churn at " << live << " " << label << ": capacity " << settled << " -> " << table.capacity()
+         << " slots, checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? atol(argv[1]) : 1000000;
+    size_t lookups = argc > 2 ? atol(argv[2]) : 4000000;
+
+    // Odd keys are inserted, even keys are the misses.
+    mt19937_64 rng(11);
+    Workload<unsigned long long> ints;
+    for (size_t i = 0; i < n; i++)
+        ints.keys.push_back(rng() | 1);
+    for (size_t i = 0; i < lookups; i++)
+    {
+        ints.hits.push_back(ints.keys[rng() % n]);
+        ints.misses.push_back(rng() & ~1ull);
+    }
+    bool ok = runAll("random 64-bit keys", ints);
+
+    Workload<string> strings;
+    for (unsigned long long k : ints.keys)
+        strings.keys.push_back("key:" + to_string(k));
+    for (size_t i = 0; i < lookups; i++)
+    {
+        strings.hits.push_back(strings.keys[rng() % n]);
+        strings.misses.push_back("key:" + to_string(rng() & ~1ull));
+    }
+    ok = runAll("string keys", strings) && ok;
+
+    ok = churnKeepsCapacity<unsigned long long>("64-bit keys", [](size_t k)
+                                                { return k * 0x9E3779B97F4A7C15ull; }) && ok;
+    ok = churnKeepsCapacity<string>("string keys", [](size_t k)
+                                    { return "key:" + to_string(k); }) && ok;
+    return ok ? 0 : 1;
+}
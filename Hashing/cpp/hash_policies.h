@@ -0,0 +1,251 @@
+#ifndef HASH_POLICIES_H
+#define HASH_POLICIES_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Hash policies for FlatHashMap / IncrementalHashMap / CustomHashTable.
+//
+// A policy is a function object returning a 64-bit hash. Policies that
+// declare `is_avalanching` promise that every output bit depends on every
+// input bit; the tables then use the value as is (low 7 bits as the control
+// tag, the rest masked to the power-of-two group count). Any other hasher,
+// std::hash included, gets an extra multiply-fold first, because std::hash
+// of an integer is usually the integer itself.
+//
+// Every built-in policy takes a seed. With the default seed 0 hashes are
+// reproducible; a table built with randomHashSeed() gets its own hash
+// function, so keys crafted offline to collide in one table (hash flooding)
+// do not collide in another. This is wyhash-strength, not SipHash: it stops
+// precomputed collision sets, not an attacker who can observe the table.
+namespace hash_detail
+{
+    const std::uint64_t kSecret0 = 0xa0761d6478bd642full;
+    const std::uint64_t kSecret1 = 0xe7037ed1a0b428dbull;
+    const std::uint64_t kSecret2 = 0x8ebc6af09c88c6e3ull;
+    const std::uint64_t kSecret3 = 0x589965cc75374cc3ull;
+
+    // 64x64 -> 128-bit multiply, folded: high half xor low half.
+    inline std::uint64_t mix(std::uint64_t a, std::uint64_t b)
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 product = (unsigned __int128)a * b;
+        return (std::uint64_t)product ^ (std::uint64_t)(product >> 64);
+#else
+        std::uint64_t ha = a >> 32, hb = b >> 32, la = (std::uint32_t)a, lb = (std::uint32_t)b;
+        std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        std::uint64_t t = rl + (rm0 << 32), carry = t < rl;
+        std::uint64_t lo = t + (rm1 << 32);
+        carry += lo < t;
+        std::uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+        return lo ^ hi;
+#endif
+    }
+
+    inline std::uint64_t read8(const unsigned char *p)
+    {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+
+    inline std::uint64_t read4(const unsigned char *p)
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    // 1..3 bytes: first, middle and last byte.
+    inline std::uint64_t read3(const unsigned char *p, std::size_t len)
+    {
+        return ((std::uint64_t)p[0] << 16) | ((std::uint64_t)p[len >> 1] << 8) | p[len - 1];
+    }
+} // namespace hash_detail
+
+// wyhash-style byte hash: 16 bytes per multiply, three independent lanes
+// for inputs over 48 bytes, and overlapping reads instead of a byte loop for
+// the tail.
+inline std::uint64_t hashBytes(const void *data, std::size_t len, std::uint64_t seed = 0)
+{
+    using namespace hash_detail;
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    seed ^= mix(seed ^ kSecret0, kSecret1);
+    std::uint64_t a, b;
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            std::size_t shift = (len >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + shift);
+            b = (read4(p + len - 4) << 32) | read4(p + len - 4 - shift);
+        }
+        else if (len > 0)
+        {
+            a = read3(p, len);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        std::size_t i = len;
+        if (i > 48)
+        {
+            std::uint64_t lane1 = seed, lane2 = seed;
+            do
+            {
+                seed = mix(read8(p) ^ kSecret1, read8(p + 8) ^ seed);
+                lane1 = mix(read8(p + 16) ^ kSecret2, read8(p + 24) ^ lane1);
+                lane2 = mix(read8(p + 32) ^ kSecret3, read8(p + 40) ^ lane2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (i > 16)
+        {
+            seed = mix(read8(p) ^ kSecret1, read8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+    return mix(kSecret1 ^ len, mix(a ^ kSecret1, b ^ seed));
+}
+
+// Multiply-shift mixer for integer keys: two folded 128-bit multiplies.
+// One round by a constant leaves the low product bits constant for keys
+// whose low bits are all zero (i << 40) and maps arithmetic progressions to
+// evenly spaced hashes; the second round makes every key set look random.
+template <typename T>
+struct IntegerHash
+{
+    using is_avalanching = void;
+    std::uint64_t seed;
+
+    explicit IntegerHash(std::uint64_t seed = 0) : seed(seed) {}
+
+    std::uint64_t operator()(T key) const
+    {
+        std::uint64_t h = hash_detail::mix((std::uint64_t)key ^ seed ^ hash_detail::kSecret0, hash_detail::kSecret1);
+        return hash_detail::mix(h, hash_detail::kSecret2);
+    }
+};
+
+// hashBytes over any string-like key. Transparent: a std::string table can
+// be searched with a string_view or a literal without a temporary string.
+struct StringHash
+{
+    using is_avalanching = void;
+    using is_transparent = void;
+    std::uint64_t seed;
+
+    explicit StringHash(std::uint64_t seed = 0) : seed(seed) {}
+
+    std::uint64_t operator()(std::string_view s) const { return hashBytes(s.data(), s.size(), seed); }
+};
+
+struct StringEqual
+{
+    using is_transparent = void;
+    bool operator()(std::string_view a, std::string_view b) const { return a == b; }
+};
+
+// Everything else: std::hash, mixed with the seed.
+template <typename T>
+struct SeededStdHash
+{
+    using is_avalanching = void;
+    std::uint64_t seed;
+
+    explicit SeededStdHash(std::uint64_t seed = 0) : seed(seed) {}
+
+    std::uint64_t operator()(const T &key) const
+    {
+        return hash_detail::mix((std::uint64_t)std::hash<T>()(key) ^ seed ^ hash_detail::kSecret0,
+                                hash_detail::kSecret1);
+    }
+};
+
+// True if Hash declares is_avalanching.
+template <typename Hash, typename = void>
+struct HashIsAvalanching : std::false_type
+{
+};
+
+template <typename Hash>
+struct HashIsAvalanching<Hash, std::void_t<typename Hash::is_avalanching>> : std::true_type
+{
+};
+
+// The policy a table picks when none is given.
+template <typename T, typename Enable = void>
+struct DefaultHashSelect
+{
+    typedef SeededStdHash<T> type;
+};
+
+template <typename T>
+struct DefaultHashSelect<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type>
+{
+    typedef IntegerHash<T> type;
+};
+
+template <>
+struct DefaultHashSelect<std::string>
+{
+    typedef StringHash type;
+};
+
+template <>
+struct DefaultHashSelect<std::string_view>
+{
+    typedef StringHash type;
+};
+
+template <typename T>
+using DefaultHash = typename DefaultHashSelect<T>::type;
+
+template <typename T>
+struct DefaultEqualSelect
+{
+    typedef std::equal_to<T> type;
+};
+
+template <>
+struct DefaultEqualSelect<std::string>
+{
+    typedef StringEqual type;
+};
+
+template <>
+struct DefaultEqualSelect<std::string_view>
+{
+    typedef StringEqual type;
+};
+
+template <typename T>
+using DefaultEqual = typename DefaultEqualSelect<T>::type;
+
+// A fresh seed per call, for tables that may see untrusted keys.
+inline std::uint64_t randomHashSeed()
+{
+    std::random_device device;
+    std::uint64_t entropy = ((std::uint64_t)device() << 32) ^ device();
+    std::uint64_t clock = (std::uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+    return hash_detail::mix(entropy ^ hash_detail::kSecret2, clock ^ hash_detail::kSecret3);
+}
+
+#endif // HASH_POLICIES_H
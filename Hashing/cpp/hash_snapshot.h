@@ -0,0 +1,347 @@
+#ifndef HASH_SNAPSHOT_H
+#define HASH_SNAPSHOT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "flat_hash_map.h"
+
+// Saving a FlatHashMap to a file that can be used in place.
+//
+// The file is the table's own layout, not a list of entries: a header, the
+// control bytes, and one fixed-size record per slot, followed by a blob with
+// the bytes of string keys / values (records hold offsets into it, never
+// pointers). MappedHashTable maps the file read-only and probes it with
+// exactly the code FlatHashMap uses, so opening costs one mmap no matter how
+// big the table is, and each lookup faults in only the pages it touches.
+//
+// Keys and values must be trivially copyable or std::string. The file is
+// for the machine that wrote it (native byte order and struct layout,
+// checked on open), and must be opened with the same Hash, including its
+// seed; the tags of the first entries are re-hashed on open to catch a
+// mismatch.
+template <typename T, typename Enable = void>
+struct SnapshotCodec
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "snapshot keys and values must be trivially copyable or std::string");
+    typedef T Stored;
+    typedef T View;
+    static Stored encode(const T &value, std::string &) { return value; }
+    static View decode(const Stored &stored, const char *, std::uint64_t) { return stored; }
+};
+
+template <>
+struct SnapshotCodec<std::string>
+{
+    struct Stored
+    {
+        std::uint64_t offset;
+        std::uint64_t length;
+    };
+    typedef std::string_view View;
+    static Stored encode(const std::string &value, std::string &blob)
+    {
+        Stored stored{blob.size(), value.size()};
+        blob += value;
+        return stored;
+    }
+    // The record comes from the file, so it is checked against the blob
+    // before the mapping is read through it.
+    static View decode(const Stored &stored, const char *blob, std::uint64_t blobSize)
+    {
+        if (stored.offset > blobSize || stored.length > blobSize - stored.offset)
+        {
+            throw std::runtime_error("MappedHashTable: corrupt string record");
+        }
+        return View(blob + stored.offset, stored.length);
+    }
+};
+
+namespace snapshot_detail
+{
+    const char kMagic[8] = {'F', 'H', 'M', 'S', 'N', 'A', 'P', '1'};
+    const std::uint32_t kByteOrder = 0x01020304u;
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t byteOrder;
+        std::uint32_t recordSize;
+        std::uint64_t slotCount;
+        std::uint64_t count;
+        std::uint64_t ctrlOffset;
+        std::uint64_t recordsOffset;
+        std::uint64_t blobOffset;
+        std::uint64_t blobSize;
+    };
+
+    inline std::uint64_t alignUp(std::uint64_t n) { return (n + 63) & ~(std::uint64_t)63; }
+
+    template <typename K, typename V>
+    struct Record
+    {
+        typename SnapshotCodec<K>::Stored key;
+        typename SnapshotCodec<V>::Stored value;
+    };
+} // namespace snapshot_detail
+
+// Writes table to path, replacing the file. Records are streamed out in
+// chunks, so only the string blob is staged in memory. The data goes to a
+// fresh temporary file next to path (mkstemp on path + ".XXXXXX", so
+// concurrent writers never share one) and is synced, then renamed over
+// path, so a process that has the old file mapped keeps reading it and a
+// crash never leaves a half-written snapshot under path. Throws
+// std::runtime_error.
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void writeSnapshot(const FlatHashMap<K, V, Hash, KeyEqual> &table, const std::string &path)
+{
+    using namespace snapshot_detail;
+    typedef Record<K, V> Rec;
+    const std::size_t slotCount = table.capacity();
+    const std::int8_t *ctrl = table.controlBytes();
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.byteOrder = kByteOrder;
+    header.recordSize = sizeof(Rec);
+    header.slotCount = slotCount;
+    header.count = table.size();
+    header.ctrlOffset = alignUp(sizeof(Header));
+    header.recordsOffset = alignUp(header.ctrlOffset + slotCount);
+    header.blobOffset = alignUp(header.recordsOffset + slotCount * sizeof(Rec));
+
+    std::string tmpPath = path + ".XXXXXX";
+    int fd = mkstemp(&tmpPath[0]);
+    std::FILE *file = fd < 0 ? nullptr : fdopen(fd, "wb");
+    if (file == nullptr)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+            std::remove(tmpPath.c_str());
+        }
+        throw std::runtime_error("writeSnapshot: cannot create a temporary file for " + path);
+    }
+    fchmod(fd, 0644); // mkstemp creates the file 0600
+    static const char zeros[64] = {};
+    std::uint64_t written = 0;
+    bool ok = true;
+    auto put = [&](std::uint64_t offset, const void *data, std::size_t bytes)
+    {
+        ok = ok && std::fwrite(zeros, 1, offset - written, file) == offset - written;
+        ok = ok && (bytes == 0 || std::fwrite(data, 1, bytes, file) == bytes);
+        written = offset + bytes;
+    };
+    put(0, &header, sizeof(header));
+    put(header.ctrlOffset, ctrl, slotCount);
+
+    std::string blob;
+    std::vector<Rec> chunk;
+    const std::size_t chunkSlots = 4096;
+    for (std::size_t first = 0; first < slotCount; first += chunkSlots)
+    {
+        std::size_t n = std::min(chunkSlots, slotCount - first);
+        chunk.assign(n, Rec()); // empty slots stay zero
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (FlatHashMap<K, V, Hash, KeyEqual>::isFullControl(ctrl[first + i]))
+            {
+                chunk[i].key = SnapshotCodec<K>::encode(table.slotData()[first + i].first, blob);
+                chunk[i].value = SnapshotCodec<V>::encode(table.slotData()[first + i].second, blob);
+            }
+        }
+        put(header.recordsOffset + first * sizeof(Rec), chunk.data(), n * sizeof(Rec));
+    }
+    put(header.blobOffset, blob.data(), blob.size());
+
+    header.blobSize = blob.size();
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && std::fflush(file) == 0 && fsync(fileno(file)) == 0;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("writeSnapshot: write failed for " + path);
+    }
+}
+
+// Read-only view of a file written by writeSnapshot. Lookups return values
+// by View: the value itself for trivially copyable types, a string_view
+// into the mapping for strings, valid while the MappedHashTable lives. A
+// string record that points outside the blob throws std::runtime_error.
+template <typename K, typename V, typename Hash = DefaultHash<K>, typename KeyEqual = DefaultEqual<K>>
+class MappedHashTable
+{
+public:
+    typedef typename SnapshotCodec<K>::View KeyView;
+    typedef typename SnapshotCodec<V>::View ValueView;
+
+private:
+    typedef FlatHashMap<K, V, Hash, KeyEqual> Layout;
+    typedef snapshot_detail::Record<K, V> Rec;
+
+    void *mapping = nullptr;
+    std::size_t mappedBytes = 0;
+    const snapshot_detail::Header *header = nullptr;
+    const std::int8_t *ctrl = nullptr;
+    const Rec *records = nullptr;
+    const char *blob = nullptr;
+    Hash hasher;
+    KeyEqual equal;
+
+    void unmap()
+    {
+        if (mapping != nullptr)
+        {
+            munmap(mapping, mappedBytes);
+            mapping = nullptr;
+        }
+    }
+
+    void fail(const std::string &path, const char *what)
+    {
+        unmap();
+        throw std::runtime_error("MappedHashTable: " + path + ": " + what);
+    }
+
+    KeyView keyAt(std::size_t i) const { return SnapshotCodec<K>::decode(records[i].key, blob, header->blobSize); }
+    ValueView valueAt(std::size_t i) const
+    {
+        return SnapshotCodec<V>::decode(records[i].value, blob, header->blobSize);
+    }
+
+public:
+    explicit MappedHashTable(const std::string &path, const Hash &hash = Hash(), const KeyEqual &keyEqual = KeyEqual())
+        : hasher(hash), equal(keyEqual)
+    {
+        using namespace snapshot_detail;
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("MappedHashTable: cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || (std::size_t)info.st_size < sizeof(Header))
+        {
+            close(fd);
+            throw std::runtime_error("MappedHashTable: " + path + ": not a snapshot");
+        }
+        mappedBytes = (std::size_t)info.st_size;
+        mapping = mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            mapping = nullptr;
+            throw std::runtime_error("MappedHashTable: cannot map " + path);
+        }
+
+        const char *base = static_cast<const char *>(mapping);
+        header = reinterpret_cast<const Header *>(base);
+        if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0)
+            fail(path, "not a snapshot");
+        if (header->byteOrder != kByteOrder || header->recordSize != sizeof(Rec))
+            fail(path, "written with a different byte order or key / value layout");
+        std::uint64_t slots = header->slotCount;
+        // Offsets are compared by difference, never by sum, so a corrupt
+        // header cannot make a check wrap around.
+        if ((slots != 0 && (slots < 16 || (slots & (slots - 1)) != 0)) || slots > mappedBytes ||
+            header->blobOffset > mappedBytes || header->blobSize > mappedBytes - header->blobOffset ||
+            header->ctrlOffset < sizeof(Header) || header->ctrlOffset > header->recordsOffset ||
+            slots > header->recordsOffset - header->ctrlOffset || header->recordsOffset > header->blobOffset ||
+            slots * sizeof(Rec) > header->blobOffset - header->recordsOffset)
+            fail(path, "corrupt header");
+        ctrl = reinterpret_cast<const std::int8_t *>(base + header->ctrlOffset);
+        records = reinterpret_cast<const Rec *>(base + header->recordsOffset);
+        blob = base + header->blobOffset;
+
+        // Re-hash the first few entries: their tags must match. They sit on
+        // the first pages of each section, so a cold open stays a handful
+        // of page faults.
+        std::size_t checked = 0;
+        for (std::size_t i = 0; i < slots && checked < 8; ++i)
+        {
+            if (Layout::isFullControl(ctrl[i]))
+            {
+                KeyView key;
+                try
+                {
+                    key = keyAt(i);
+                }
+                catch (const std::runtime_error &)
+                {
+                    fail(path, "corrupt string record");
+                }
+                if (Layout::controlTag(Layout::hashWith(hasher, key)) != ctrl[i])
+                    fail(path, "written with a different hash function or seed");
+                ++checked;
+            }
+        }
+    }
+
+    MappedHashTable(const MappedHashTable &) = delete;
+    MappedHashTable &operator=(const MappedHashTable &) = delete;
+
+    MappedHashTable(MappedHashTable &&other) noexcept
+        : mapping(other.mapping), mappedBytes(other.mappedBytes), header(other.header), ctrl(other.ctrl),
+          records(other.records), blob(other.blob), hasher(std::move(other.hasher)), equal(std::move(other.equal))
+    {
+        other.mapping = nullptr;
+    }
+
+    ~MappedHashTable() { unmap(); }
+
+    std::size_t size() const { return header->count; }
+    std::size_t fileBytes() const { return mappedBytes; }
+
+    // Copies the value of key into value. Returns false if absent.
+    template <typename Q>
+    bool find(const Q &key, ValueView &value) const
+    {
+        std::size_t index = Layout::probe(ctrl, header->slotCount, Layout::hashWith(hasher, key),
+                                          [&](std::size_t i)
+                                          { return equal(keyAt(i), key); });
+        if (index == header->slotCount)
+        {
+            return false;
+        }
+        value = valueAt(index);
+        return true;
+    }
+
+    template <typename Q>
+    bool contains(const Q &key) const
+    {
+        ValueView ignored;
+        return find(key, ignored);
+    }
+
+    // Calls visit(key, value) with views of every entry, in slot order.
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (std::size_t i = 0; i < header->slotCount; ++i)
+        {
+            if (Layout::isFullControl(ctrl[i]))
+            {
+                visit(keyAt(i), valueAt(i));
+            }
+        }
+    }
+};
+
+#endif // HASH_SNAPSHOT_H
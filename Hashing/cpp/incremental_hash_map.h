@@ -0,0 +1,252 @@
+#ifndef INCREMENTAL_HASH_MAP_H
+#define INCREMENTAL_HASH_MAP_H
+
+#include <cstddef>
+#include <utility>
+#include "flat_hash_map.h"
+
+// FlatHashMap that grows without stopping the world.
+//
+// A plain FlatHashMap doubles by moving every entry inside the one insert
+// that crosses the load limit, so with millions of keys that insert takes
+// milliseconds. Here growing only allocates the doubled table (its control
+// bytes come from calloc, so even that is lazy) and keeps the old one as
+// `previous`. Each later insert / erase then moves the entries of the next
+// `step` slots of the old table across. Until the old table is drained,
+// lookups try the new table and then the old one; every key lives in
+// exactly one of the two.
+//
+// The new table has room for all old entries plus as many new ones, so with
+// step >= 2 the migration always ends before the new table fills up. If it
+// does fill up anyway the remaining migration is finished on the spot.
+// step == 0 migrates everything at once, i.e. classic stop-the-world growth.
+//
+// The total migration work is the same for every step; the step only decides
+// which inserts pay for it. Over a run of growths about 2 / step of all
+// inserts land in a migration, each costing roughly step slot moves. A small
+// step therefore slows a few percent of inserts and raises p99 / p999; a
+// large one keeps those at stop-the-world level and bounds the worst insert
+// by step slots instead of the whole table. The default of 512 leaves p99
+// at stop-the-world level and puts the migrating inserts, about 0.4%, at
+// ten to twenty microseconds each (rehashLatencyBenchmark).
+//
+// The drained old table is handed back to the OS a few pages at a time as
+// the migration passes them, so freeing it at the end is cheap too; a
+// single munmap of a large, fully touched table takes milliseconds.
+template <typename K, typename V, typename Hash = DefaultHash<K>, typename KeyEqual = DefaultEqual<K>>
+class IncrementalHashMap
+{
+public:
+    typedef FlatHashMap<K, V, Hash, KeyEqual> Table;
+
+private:
+    Table current;
+    Table previous;
+    std::size_t cursor = 0;    // next slot of `previous` to migrate
+    std::size_t discarded = 0; // slots of `previous` before this are freed
+    bool migrating = false;
+    std::size_t step;
+    std::size_t maxSlots = 0; // most slots migrated by one operation
+    Hash hasher;
+    KeyEqual equal;
+
+    // Drained slots are handed back to the OS in pieces of this size, so
+    // releasing the old table at the end does not free it all at once.
+    static const std::size_t kDiscardBytes = 256 * 1024;
+
+    void migrate(std::size_t slotBudget)
+    {
+        std::size_t from = cursor;
+        cursor = previous.migrateOut(cursor, slotBudget, [this](K &&key, V &&value)
+                                     { current.emplace(std::move(key), std::move(value)); });
+        if (cursor - from > maxSlots)
+        {
+            maxSlots = cursor - from;
+        }
+        if (cursor == previous.capacity())
+        {
+            previous = Table();
+            cursor = 0;
+            discarded = 0;
+            migrating = false;
+        }
+        else if ((cursor - discarded) * sizeof(typename Table::Slot) >= kDiscardBytes)
+        {
+            discarded = previous.discardSlots(discarded, cursor);
+        }
+    }
+
+    // Called at the start of every mutating operation.
+    void advance()
+    {
+        if (migrating)
+        {
+            migrate(step);
+        }
+    }
+
+    // Before inserting a key that is in neither table.
+    void makeRoom(const K &key)
+    {
+        if (!current.atGrowthLimit() || current.contains(key))
+        {
+            return;
+        }
+        if (migrating)
+        {
+            migrate(previous.capacity());
+        }
+        if (!current.atGrowthLimit())
+        {
+            return;
+        }
+        // Double the slot count like FlatHashMap does, or keep it when the
+        // table is mostly tombstones, so insert / erase churn at a steady
+        // size does not grow it without bound. Reserving by element count
+        // would round 2 * size up past that and quadruple the table.
+        std::size_t slots = current.rehashesInPlace() ? current.capacity() : 2 * current.capacity();
+        previous = std::move(current);
+        current = Table(slots ? slots - slots / 8 - 1 : 0, hasher, equal);
+        cursor = 0;
+        discarded = 0;
+        migrating = true;
+        if (step == 0)
+        {
+            migrate(previous.capacity());
+        }
+    }
+
+public:
+    explicit IncrementalHashMap(std::size_t slotsPerOperation = 512, std::size_t expected = 0,
+                                const Hash &hash = Hash(), const KeyEqual &keyEqual = KeyEqual())
+        : current(expected, hash, keyEqual), step(slotsPerOperation), hasher(hash), equal(keyEqual)
+    {
+    }
+
+    // Slots migrated per insert / erase while growing; 0 = all at once.
+    void setMigrationStep(std::size_t slotsPerOperation) { step = slotsPerOperation; }
+    std::size_t migrationStep() const { return step; }
+    bool isMigrating() const { return migrating; }
+
+    // The most slots of an old table one operation has migrated so far,
+    // i.e. the measured bound on the extra work of a single insert / erase.
+    // finishMigration() and reserve() count as one operation too.
+    std::size_t maxMigratedSlots() const { return maxSlots; }
+
+    std::size_t size() const { return current.size() + previous.size(); }
+    bool empty() const { return size() == 0; }
+    std::size_t capacity() const { return current.capacity(); }
+
+    // Finishes any migration, then reserves like FlatHashMap::reserve.
+    void reserve(std::size_t elements)
+    {
+        finishMigration();
+        current.reserve(elements);
+    }
+
+    // Moves whatever is left of a migration now.
+    void finishMigration()
+    {
+        if (migrating)
+        {
+            migrate(previous.capacity());
+        }
+    }
+
+    // The single table holding every entry; call finishMigration() first.
+    const Table &table() const { return current; }
+
+    void clear()
+    {
+        current.clear();
+        previous.clear();
+        cursor = 0;
+        discarded = 0;
+        migrating = false;
+    }
+
+    // Inserts key -> value unless the key exists. Returns true if inserted.
+    bool insert(const K &key, const V &value)
+    {
+        advance();
+        if (migrating && previous.contains(key))
+        {
+            return false;
+        }
+        makeRoom(key);
+        return current.insert(key, value);
+    }
+
+    // Inserts or overwrites. Returns true if the key was new.
+    template <typename VArg>
+    bool insertOrAssign(const K &key, VArg &&value)
+    {
+        advance();
+        if (migrating)
+        {
+            if (V *old = previous.find(key))
+            {
+                *old = std::forward<VArg>(value);
+                return false;
+            }
+        }
+        makeRoom(key);
+        return current.insertOrAssign(key, std::forward<VArg>(value));
+    }
+
+    V &operator[](const K &key)
+    {
+        advance();
+        if (migrating)
+        {
+            if (V *old = previous.find(key))
+            {
+                return *old;
+            }
+        }
+        makeRoom(key);
+        return current[key];
+    }
+
+    template <typename Q>
+    V *find(const Q &key)
+    {
+        V *found = current.find(key);
+        return found == nullptr && migrating ? previous.find(key) : found;
+    }
+
+    template <typename Q>
+    const V *find(const Q &key) const
+    {
+        const V *found = current.find(key);
+        return found == nullptr && migrating ? previous.find(key) : found;
+    }
+
+    template <typename Q>
+    bool contains(const Q &key) const { return find(key) != nullptr; }
+
+    template <typename Q>
+    bool erase(const Q &key)
+    {
+        advance();
+        return current.erase(key) || (migrating && previous.erase(key));
+    }
+
+    // Calls visit(key, value) for every entry of both tables.
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        current.forEach(visit);
+        previous.forEach(visit);
+    }
+
+    // Probe histogram of the current table (see FlatHashMap).
+    std::vector<std::size_t> probeHistogram() const { return current.probeHistogram(); }
+
+    std::size_t memoryBytes() const { return current.memoryBytes() + previous.memoryBytes(); }
+};
+
+template <typename K, typename V, typename H, typename E>
+const std::size_t IncrementalHashMap<K, V, H, E>::kDiscardBytes;
+
+#endif // INCREMENTAL_HASH_MAP_H
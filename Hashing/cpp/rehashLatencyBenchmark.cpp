@@ -0,0 +1,136 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include "incremental_hash_map.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Per-insert latency while a table grows from empty to `keys` entries, for
+// stop-the-world growth (FlatHashMap, and IncrementalHashMap with step 0)
+// and incremental growth with several migration steps. Every insert is timed
+// on its own; the table doubles about log2(keys) times, so a full rehash
+// shows up in the max and the far tail, while the incremental variants pay
+// a little on every insert during a migration instead. The ">100us" column
+// counts inserts slower than 100 us. The "no insert" row times the same loop
+// without the insert: its max and >100us are the machine's noise floor
+// (preemption, interrupts), which every variant shares. "max slots" is the
+// most old-table slots a single insert migrated, counted by the map; it is
+// the bound on an incremental insert's extra work, and the checks fail if it
+// exceeds the step.
+//
+// Usage: ./rehashLatencyBenchmark [keys]   (default 8000000)
+
+struct Latencies
+{
+    vector<uint32_t> ns;
+    double totalSeconds = 0;
+};
+
+template <typename Table>
+Latencies measure(Table &table, const vector<uint64_t> &keys)
+{
+    Latencies result;
+    result.ns.reserve(keys.size());
+    auto begin = chrono::steady_clock::now();
+    auto last = begin;
+    for (uint64_t key : keys)
+    {
+        table.insert(key, key);
+        auto now = chrono::steady_clock::now();
+        result.ns.push_back((uint32_t)min<int64_t>(chrono::duration_cast<chrono::nanoseconds>(now - last).count(), UINT32_MAX));
+        last = now;
+    }
+    result.totalSeconds = chrono::duration<double>(last - begin).count();
+    return result;
+}
+
+// The timing loop of measure() with nothing in it.
+Latencies measureNothing(size_t n)
+{
+    Latencies result;
+    result.ns.reserve(n);
+    auto begin = chrono::steady_clock::now();
+    auto last = begin;
+    for (size_t i = 0; i < n; i++)
+    {
+        auto now = chrono::steady_clock::now();
+        result.ns.push_back((uint32_t)min<int64_t>(chrono::duration_cast<chrono::nanoseconds>(now - last).count(), UINT32_MAX));
+        last = now;
+    }
+    result.totalSeconds = chrono::duration<double>(last - begin).count();
+    return result;
+}
+
+void report(const string &label, Latencies l, size_t maxSlots = 0)
+{
+    size_t n = l.ns.size();
+    auto at = [&](double q)
+    {
+        size_t k = min(n - 1, (size_t)(q * n));
+        nth_element(l.ns.begin(), l.ns.begin() + k, l.ns.end());
+        return (double)l.ns[k];
+    };
+    double slow = (double)count_if(l.ns.begin(), l.ns.end(), [](uint32_t ns)
+                                   { return ns > 100000; });
+    double mean = l.totalSeconds * 1e9 / n;
+    double p50 = at(0.5), p99 = at(0.99), p999 = at(0.999), p9999 = at(0.9999);
+    double max = *max_element(l.ns.begin(), l.ns.end());
+    if (maxSlots)
+        report(label, {{mean, "ns mean", 1}, {p50, "ns p50", 0}, {p99, "ns p99", 0}, {p999, "ns p999", 0}, {p9999, "ns p9999", 0}, {max, "ns max", 0}, {slow, ">100us", 0}, {(double)maxSlots, "max slots", 0}}, 22);
+    else
+        report(label, {{mean, "ns mean", 1}, {p50, "ns p50", 0}, {p99, "ns p99", 0}, {p999, "ns p999", 0}, {p9999, "ns p9999", 0}, {max, "ns max", 0}, {slow, ">100us", 0}}, 22);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? atol(argv[1]) : 8000000;
+    mt19937_64 rng(5);
+    vector<uint64_t> keys(n);
+    for (uint64_t &k : keys)
+        k = rng();
+
+    benchSection("insert latency");
+    bool ok = true;
+    report("no insert", measureNothing(n));
+    {
+        FlatHashMap<uint64_t, uint64_t> table;
+        report("FlatHashMap", measure(table, keys));
+        ok = ok && table.size() == n;
+    }
+    for (size_t step : {0, 8, 64, 512, 4096})
+    {
+        IncrementalHashMap<uint64_t, uint64_t> table(step);
+        Latencies l = measure(table, keys);
+        report(step == 0 ? "incremental step 0" : "incremental step " + to_string(step), l, table.maxMigratedSlots());
+        ok = ok && (step == 0 || table.maxMigratedSlots() <= step);
+        for (size_t i = 0; i < n; i += 97)
+            ok = ok && table.contains(keys[i]);
+        ok = ok && table.size() == n;
+    }
+
+    // Insert / erase churn at a steady size must not grow the table: once
+    // the tombstones fill it, it migrates into a table of the same size.
+    {
+        size_t live = 850; // 2048 slots: below half the growth limit, but
+                           // full enough that erases leave tombstones
+        IncrementalHashMap<uint64_t, uint64_t> table(64, 1000);
+        for (size_t i = 0; i < live; i++)
+            table.insert(i, i);
+        size_t settled = table.capacity();
+        for (uint64_t k = live; k < live + 500 * settled; k++)
+        {
+            table.insert(k, k);
+            table.erase(k - live);
+        }
+        ok = ok && table.size() == live && table.capacity() == settled;
+        cout << "churn at " << live << " keys: capacity " << settled << " -> " << table.capacity() << " slots" << endl;
+    }
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
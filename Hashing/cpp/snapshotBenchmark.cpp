@@ -0,0 +1,208 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include "hash_snapshot.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Cold start of a large table two ways:
+//   rebuild   read a flat dump of the entries and insert them one by one
+//   snapshot  open a writeSnapshot file with MappedHashTable
+// Both files are evicted from the page cache first (posix_fadvise), so the
+// numbers include reading from the disk. After opening, the time to the
+// first 1000 lookups and the steady-state lookup cost are compared with the
+// rebuilt in-memory table. Runs for 64-bit keys / values and for string
+// keys / values.
+//
+// Usage: ./snapshotBenchmark [keys] [directory]   (default 4000000 /tmp)
+
+void reportMs(const string &label, double seconds)
+{
+    report(label, {{seconds * 1e3, "ms"}}, 36);
+}
+
+void reportNs(const string &label, size_t n, double seconds)
+{
+    report(label, {{seconds * 1e9 / n, "ns/op"}}, 36);
+}
+
+void dropFromPageCache(const string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// Dump format for the rebuild path: length-prefixed records.
+void writeValue(FILE *f, uint64_t v) { fwrite(&v, sizeof(v), 1, f); }
+void writeValue(FILE *f, const string &s)
+{
+    uint32_t length = (uint32_t)s.size();
+    fwrite(&length, sizeof(length), 1, f);
+    fwrite(s.data(), 1, s.size(), f);
+}
+bool readValue(FILE *f, uint64_t &v) { return fread(&v, sizeof(v), 1, f) == 1; }
+bool readValue(FILE *f, string &s)
+{
+    uint32_t length;
+    if (fread(&length, sizeof(length), 1, f) != 1)
+        return false;
+    s.resize(length);
+    return fread(&s[0], 1, length, f) == length;
+}
+
+template <typename K, typename V>
+bool run(const string &title, const vector<K> &keys, const vector<V> &values, const string &directory)
+{
+    benchSection(title, to_string(keys.size()) + " entries");
+    string dumpPath = directory + "/hash_benchmark.dump";
+    string snapshotPath = directory + "/hash_benchmark.snapshot";
+
+    {
+        FlatHashMap<K, V> table;
+        FILE *dump = fopen(dumpPath.c_str(), "wb");
+        if (dump == nullptr)
+        {
+            cout << "  cannot write to " << directory << endl;
+            return false;
+        }
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            writeValue(dump, keys[i]);
+            writeValue(dump, values[i]);
+            table.insert(keys[i], values[i]);
+        }
+        fclose(dump);
+        reportMs("  writeSnapshot", timeIt([&]()
+                                           { writeSnapshot(table, snapshotPath); }));
+    }
+    dropFromPageCache(dumpPath);
+    dropFromPageCache(snapshotPath);
+
+    mt19937_64 rng(9);
+    vector<size_t> probes(1000000);
+    for (size_t &p : probes)
+        p = rng() % keys.size();
+
+    FlatHashMap<K, V> rebuilt;
+    double rebuild = timeIt([&]()
+                            {
+        FILE *dump = fopen(dumpPath.c_str(), "rb");
+        K key;
+        V value;
+        while (readValue(dump, key) && readValue(dump, value))
+            rebuilt.insert(key, value);
+        fclose(dump); });
+    size_t found = 0;
+    double rebuildFirst = timeIt([&]()
+                                 {
+        for (size_t i = 0; i < 1000; i++)
+            found += rebuilt.contains(keys[probes[i]]); });
+    reportMs("  rebuild from dump", rebuild);
+    reportMs("  rebuild + first 1000 lookups", rebuild + rebuildFirst);
+
+    size_t mappedFound = 0, fileBytes = 0;
+    double open = 0, mappedFirst = 0, mappedWarm = 0;
+    {
+        MappedHashTable<K, V> *mapped = nullptr;
+        open = timeIt([&]()
+                      { mapped = new MappedHashTable<K, V>(snapshotPath); });
+        mappedFirst = timeIt([&]()
+                             {
+            for (size_t i = 0; i < 1000; i++)
+                mappedFound += mapped->contains(keys[probes[i]]); });
+        mappedWarm = timeIt([&]()
+                            {
+            for (size_t p : probes)
+                mappedFound += mapped->contains(keys[p]); });
+        fileBytes = mapped->fileBytes();
+        delete mapped;
+    }
+    reportMs("  snapshot open", open);
+    reportMs("  snapshot open + first 1000 lookups", open + mappedFirst);
+
+    double memoryWarm = timeIt([&]()
+                               {
+        for (size_t p : probes)
+            found += rebuilt.contains(keys[p]); });
+    reportNs("  lookup in rebuilt table", probes.size(), memoryWarm);
+    reportNs("  lookup in mapped snapshot", probes.size(), mappedWarm);
+    report("  snapshot file", {{fileBytes / 1048576.0, "MiB", 1}}, 36);
+
+    remove(dumpPath.c_str());
+    remove(snapshotPath.c_str());
+    bool ok = found == 1000 + probes.size() && mappedFound == 1000 + probes.size() && rebuilt.size() == keys.size();
+    cout << "  checks: " << (ok ? "ok" : "FAILED") << endl
+         << endl;
+    return ok;
+}
+
+// A corrupt file whose control bytes have no empty byte (here: every empty
+// slot rewritten as a tombstone) must still answer a miss instead of
+// probing forever.
+bool missOnCorruptControl(const string &directory)
+{
+    string path = directory + "/hash_benchmark_corrupt.snapshot";
+    FlatHashMap<uint64_t, uint64_t> table;
+    for (uint64_t i = 0; i < 100; i++)
+        table.insert(i, i);
+    writeSnapshot(table, path);
+
+    FILE *f = fopen(path.c_str(), "r+b");
+    snapshot_detail::Header header;
+    bool ok = f != nullptr && fread(&header, sizeof(header), 1, f) == 1;
+    vector<int8_t> ctrl(ok ? header.slotCount : 0);
+    ok = ok && fseek(f, (long)header.ctrlOffset, SEEK_SET) == 0 && fread(ctrl.data(), 1, ctrl.size(), f) == ctrl.size();
+    for (int8_t &c : ctrl)
+        if (c == 0)
+            c = 1;
+    ok = ok && fseek(f, (long)header.ctrlOffset, SEEK_SET) == 0 && fwrite(ctrl.data(), 1, ctrl.size(), f) == ctrl.size();
+    if (f != nullptr)
+        fclose(f);
+    if (ok)
+    {
+        MappedHashTable<uint64_t, uint64_t> mapped(path);
+        ok = !mapped.contains(uint64_t(1000)) && mapped.contains(uint64_t(42));
+    }
+    remove(path.c_str());
+    cout << "corrupt control bytes, miss terminates: " << (ok ? "ok" : "FAILED") << endl
+         << endl;
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? atol(argv[1]) : 4000000;
+    string directory = argc > 2 ? argv[2] : "/tmp";
+
+    mt19937_64 rng(1);
+    vector<uint64_t> intKeys(n), intValues(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        intKeys[i] = rng();
+        intValues[i] = i;
+    }
+    bool ok = run("uint64 -> uint64", intKeys, intValues, directory);
+
+    size_t m = n / 4;
+    vector<string> stringKeys(m), stringValues(m);
+    for (size_t i = 0; i < m; i++)
+    {
+        stringKeys[i] = "session:" + to_string(intKeys[i]);
+        stringValues[i] = "user=" + to_string(i) + ";region=eu-west;flags=" + to_string(intKeys[i] % 977);
+    }
+    ok = run("string -> string", stringKeys, stringValues, directory) && ok;
+    ok = missOnCorruptControl(directory) && ok;
+    return ok ? 0 : 1;
+}
@@ -1,6 +1,8 @@
 #ifndef CIRCULAR_LINKED_LIST_H
 #define CIRCULAR_LINKED_LIST_H
 
+#include <cstddef>
+
 // Node structure for Circular Linked List
 struct Node {
     int data;    // Data stored in the node
@@ -10,18 +12,53 @@ struct Node {
     Node(int val);
 };
 
+class RoundRobinCursor;
+
 // CircularLinkedList class declaration
+//
+// The list only keeps a pointer to its last node: the first node is
+// tail->next, so both ends are one step away. Inserting at the beginning or
+// the end and removing the first node are O(1); finding a value is still a
+// walk around the ring.
+//
+// RoundRobinCursors registered on the list are kept valid by every insert
+// and removal (see RoundRobinCursor). Each of those operations also costs
+// O(number of cursors), which is meant to be a handful. The list is not
+// thread-safe: threads sharing it must hold a lock around every call,
+// cursor calls included.
 class CircularLinkedList {
 private:
-    Node* head; // Pointer to the first node (head) of the circular linked list
+    Node* tail;       // Pointer to the last node; tail->next is the first
+    std::size_t count;
+    RoundRobinCursor* cursors; // Registered cursors, linked through the cursors
+
+    // Function to link a new node between the last and the first node
+    void insertBeforeHead(Node* newNode);
+
+    // Function to unlink and delete the node after prev
+    void removeAfter(Node* prev);
+
+    friend class RoundRobinCursor;
 
 public:
     // Constructor to initialize an empty list
     CircularLinkedList();
 
-    // Function to insert a node at the end
+    // Destructor to free every node and detach the cursors
+    ~CircularLinkedList();
+
+    CircularLinkedList(const CircularLinkedList&) = delete;
+    CircularLinkedList& operator=(const CircularLinkedList&) = delete;
+
+    // Function to insert a node at the beginning, O(1)
+    void insertAtBeginning(int value);
+
+    // Function to insert a node at the end, O(1)
     void insertAtEnd(int value);
 
+    // Function to delete the first node, O(1); returns false if empty
+    bool deleteAtBeginning();
+
     // Function to delete a node by value
     void deleteNode(int value);
 
@@ -33,6 +70,52 @@ public:
 
     // Function to search for an element in the list
     bool search(int value);
+
+    // Function to get the number of nodes
+    std::size_t size() const;
+};
+
+// Round-robin position in a CircularLinkedList, e.g. for dispatching
+// requests across backends: next() hands out the values in ring order,
+// starting with the first node, and wraps around forever.
+//
+// The cursor stays valid whatever else happens to the list. If the node it
+// returned last is removed, through deleteNode, deleteAtBeginning or
+// another cursor, the next call continues with that node's successor.
+// A node inserted at the end is reached before the cursor wraps around,
+// one inserted at the beginning once it has. If the list is destroyed
+// first, next() returns false.
+//
+// Internally the cursor holds the node before the current one; that is what
+// lets removeCurrent() unlink the current node in O(1).
+class RoundRobinCursor {
+private:
+    CircularLinkedList* list;
+    Node* prev;       // Node before the current one; nullptr before the first call
+                      // and whenever the list has been emptied
+    bool hasCurrent;  // Whether prev->next is the node returned last
+    RoundRobinCursor* prevCursor; // Neighbours in the list's cursor chain
+    RoundRobinCursor* nextCursor;
+
+    friend class CircularLinkedList;
+
+public:
+    // Constructor to register a cursor that starts at the first node
+    explicit RoundRobinCursor(CircularLinkedList& list);
+
+    // Destructor to unregister the cursor
+    ~RoundRobinCursor();
+
+    RoundRobinCursor(const RoundRobinCursor&) = delete;
+    RoundRobinCursor& operator=(const RoundRobinCursor&) = delete;
+
+    // Function to get the next value in round-robin order; returns false
+    // if the list is empty
+    bool next(int& value);
+
+    // Function to delete the node returned last, O(1); returns false if it
+    // is already gone or next() was not called yet
+    bool removeCurrent();
 };
 
 #endif // CIRCULAR_LINKED_LIST_H
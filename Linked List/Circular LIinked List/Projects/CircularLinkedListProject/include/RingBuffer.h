@@ -0,0 +1,212 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Fixed-capacity ring buffers for producer / consumer pipelines.
+//
+// CircularLinkedList models a ring with one heap node per element; these
+// keep the elements in one array whose size is a power of two, so an index
+// maps to its slot with a mask, and the ring never allocates after it is
+// built. Both are lock-free and hand elements over in FIFO order.
+//
+//   SpscRingBuffer  one producer thread, one consumer thread
+//   MpmcRingBuffer  any number of producers and consumers
+//
+// Every operation has a batch form that moves up to `count` elements with
+// one synchronization, for producers and consumers that work in bursts. The
+// indices written by the two sides live on separate cache lines, so a
+// producer and a consumer never invalidate each other's line except to
+// publish.
+//
+// T must be default constructible and copy assignable. The padding is only
+// guaranteed for rings declared on the stack, statically or as members;
+// before C++17, `new` ignores the extended alignment.
+
+const std::size_t kCacheLine = 64;
+
+inline std::size_t roundUpToPowerOfTwo(std::size_t n)
+{
+    std::size_t size = 1;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+template <typename T>
+class SpscRingBuffer {
+private:
+    // head: next slot to read (written by the consumer only).
+    // tail: next slot to write (written by the producer only).
+    // Each side keeps a stale copy of the other side's index and only
+    // re-reads the shared one when the copy says the ring is full / empty.
+    alignas(kCacheLine) std::atomic<std::size_t> head;
+    std::size_t cachedTail;
+    alignas(kCacheLine) std::atomic<std::size_t> tail;
+    std::size_t cachedHead;
+    alignas(kCacheLine) std::size_t mask;
+    std::unique_ptr<T[]> slots;
+
+public:
+    // capacity is rounded up to a power of two.
+    explicit SpscRingBuffer(std::size_t capacity)
+        : head(0), cachedTail(0), tail(0), cachedHead(0),
+          mask(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity) - 1),
+          slots(new T[mask + 1]) {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+
+    // Number of elements, exact only when neither side is running.
+    std::size_t size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    // Producer: appends up to count elements, returns how many fit.
+    std::size_t pushBatch(const T* values, std::size_t count)
+    {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        std::size_t room = capacity() - (t - cachedHead);
+        if (room < count) {
+            cachedHead = head.load(std::memory_order_acquire);
+            room = capacity() - (t - cachedHead);
+        }
+        std::size_t n = count < room ? count : room;
+        for (std::size_t i = 0; i < n; ++i) {
+            slots[(t + i) & mask] = values[i];
+        }
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer: removes up to count elements into out, returns how many.
+    std::size_t popBatch(T* out, std::size_t count)
+    {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        std::size_t ready = cachedTail - h;
+        if (ready < count) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            ready = cachedTail - h;
+        }
+        std::size_t n = count < ready ? count : ready;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = slots[(h + i) & mask];
+        }
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    // Producer: returns false if the ring is full.
+    bool tryPush(const T& value) { return pushBatch(&value, 1) == 1; }
+
+    // Consumer: returns false if the ring is empty.
+    bool tryPop(T& value) { return popBatch(&value, 1) == 1; }
+};
+
+// Bounded MPMC queue after Dmitry Vyukov's design: every slot carries a
+// sequence number that says whose turn it is. A producer may fill slot
+// `pos & mask` when its sequence equals pos and publishes it by storing
+// pos + 1; a consumer may empty it when the sequence equals pos + 1 and
+// frees it for the next lap by storing pos + capacity. Claiming a position
+// is one CAS on the shared index; a batch claims a run of ready slots with
+// a single CAS.
+template <typename T>
+class MpmcRingBuffer {
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    alignas(kCacheLine) std::atomic<std::size_t> enqueuePos;
+    alignas(kCacheLine) std::atomic<std::size_t> dequeuePos;
+    alignas(kCacheLine) std::size_t mask;
+    std::unique_ptr<Slot[]> slots;
+
+    // Claims up to count consecutive positions from index whose slots have
+    // sequence == pos + offset. Returns how many were claimed and their
+    // first position.
+    std::size_t claim(std::atomic<std::size_t>& index, std::size_t offset, std::size_t count,
+                      std::size_t& first)
+    {
+        std::size_t pos = index.load(std::memory_order_relaxed);
+        for (;;) {
+            std::size_t n = 0;
+            while (n < count &&
+                   slots[(pos + n) & mask].sequence.load(std::memory_order_acquire) == pos + n + offset) {
+                ++n;
+            }
+            if (n == 0) {
+                // Either the ring is full / empty, or another thread moved
+                // index past pos; retry only in the second case.
+                std::size_t now = index.load(std::memory_order_relaxed);
+                if (now == pos) {
+                    return 0;
+                }
+                pos = now;
+                continue;
+            }
+            if (index.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                first = pos;
+                return n;
+            }
+        }
+    }
+
+public:
+    // capacity is rounded up to a power of two.
+    explicit MpmcRingBuffer(std::size_t capacity)
+        : enqueuePos(0), dequeuePos(0),
+          mask(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity) - 1),
+          slots(new Slot[mask + 1])
+    {
+        for (std::size_t i = 0; i <= mask; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+    MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+
+    // Appends up to count elements, returns how many were enqueued.
+    std::size_t pushBatch(const T* values, std::size_t count)
+    {
+        std::size_t first = 0;
+        std::size_t n = claim(enqueuePos, 0, count, first);
+        for (std::size_t i = 0; i < n; ++i) {
+            Slot& slot = slots[(first + i) & mask];
+            slot.value = values[i];
+            slot.sequence.store(first + i + 1, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // Removes up to count elements into out, returns how many.
+    std::size_t popBatch(T* out, std::size_t count)
+    {
+        std::size_t first = 0;
+        std::size_t n = claim(dequeuePos, 1, count, first);
+        for (std::size_t i = 0; i < n; ++i) {
+            Slot& slot = slots[(first + i) & mask];
+            out[i] = slot.value;
+            slot.sequence.store(first + i + mask + 1, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // Returns false if the ring is full.
+    bool tryPush(const T& value) { return pushBatch(&value, 1) == 1; }
+
+    // Returns false if the ring is empty.
+    bool tryPop(T& value) { return popBatch(&value, 1) == 1; }
+};
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,91 @@
+# Compares two CSV reports written by bench_report.awk and prints every
+# measurement present in both, with its relative change. Rates ("/s") and
+# hit ratios are better when higher, everything else (times, latencies,
+# probe counts, bytes) when lower. A change for the worse beyond `threshold`
+# percent (default 5) is marked REGRESSION and makes the exit status 1.
+#
+# Usage: awk -v threshold=5 -f bench_compare.awk baseline.csv current.csv
+#
+# Measurements are matched on benchmark, section, label and metric, not on
+# variant, so a release report can be compared with an lto or pgo one.
+
+# Splits one CSV line into fields[1..n]; quoted fields may hold commas and
+# doubled quotes.
+function parseCsv(line, fields,    n, i, c, field, quoted) {
+    n = 0
+    field = ""
+    quoted = 0
+    for (i = 1; i <= length(line); i++) {
+        c = substr(line, i, 1)
+        if (quoted) {
+            if (c == "\"" && substr(line, i + 1, 1) == "\"") {
+                field = field c
+                i++
+            } else if (c == "\"") {
+                quoted = 0
+            } else {
+                field = field c
+            }
+        } else if (c == "\"") {
+            quoted = 1
+        } else if (c == ",") {
+            fields[++n] = field
+            field = ""
+        } else {
+            field = field c
+        }
+    }
+    fields[++n] = field
+    return n
+}
+
+function higherIsBetter(metric) {
+    return metric ~ /\/s$/ || metric ~ /^% /
+}
+
+BEGIN {
+    if (threshold == "") {
+        threshold = 5
+    }
+    regressions = 0
+}
+
+FNR == 1 {
+    file++
+    next
+}
+
+{
+    sub(/\r$/, "")
+    if (parseCsv($0, f) < 6) {
+        next
+    }
+    key = f[2] SUBSEP f[3] SUBSEP f[4] SUBSEP f[5]
+    if (file == 1) {
+        baseline[key] = f[6]
+        next
+    }
+    if (!(key in baseline)) {
+        next
+    }
+    old = baseline[key] + 0
+    now = f[6] + 0
+    if (old == 0) {
+        change = 0
+    } else {
+        change = 100 * (now - old) / old
+    }
+    worse = higherIsBetter(f[5]) ? -change : change
+    mark = ""
+    if (worse > threshold) {
+        mark = "  REGRESSION"
+        regressions++
+    }
+    name = f[2] ": " (f[3] != "" ? f[3] " / " : "") f[4] " [" f[5] "]"
+    printf "%-80s %12s -> %-12s %+7.1f %%%s\n", name, baseline[key], f[6], change, mark
+}
+
+END {
+    printf "\n%d regression(s) beyond %s %%\n", regressions, threshold
+    exit regressions > 0 ? 1 : 0
+}
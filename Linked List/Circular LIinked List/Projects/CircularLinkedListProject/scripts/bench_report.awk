@@ -0,0 +1,81 @@
+# Turns the benchmarks' structured result lines into one record per
+# measurement, as CSV (format=csv, the default) or a JSON array
+# (format=json):
+#
+#   variant, benchmark, section, label, metric, value
+#
+# Usage: awk -v variant=release -v format=csv -f bench_report.awk build/release/bench/*.txt
+#
+# The benchmark name is the input file name without directory and ".txt".
+# Only lines of the form
+#
+#   BENCH,<section>,<label>,<metric>,<value>
+#
+# are read (bench/bench_util.h prints one per measurement next to the human
+# readable row); everything else is skipped, so the layout of the rows can
+# change without touching the report. A label repeated under the same
+# section and metric is numbered " #2", " #3". A BENCH line without five
+# fields or with a value that is not a number is an error.
+
+function csvField(s) {
+    gsub(/"/, "\"\"", s)
+    return "\"" s "\""
+}
+
+function jsonString(s) {
+    gsub(/\\/, "\\\\", s)
+    gsub(/"/, "\\\"", s)
+    return "\"" s "\""
+}
+
+function emit(section, label, metric, value,    key) {
+    key = benchmark SUBSEP section SUBSEP label SUBSEP metric
+    if (++seen[key] > 1) {
+        label = label " #" seen[key]
+    }
+    if (format == "json") {
+        printf "%s\n  {\"variant\": %s, \"benchmark\": %s, \"section\": %s, \"label\": %s, \"metric\": %s, \"value\": %s}",
+               (records > 0 ? "," : ""), jsonString(variant), jsonString(benchmark), jsonString(section),
+               jsonString(label), jsonString(metric), value
+    } else {
+        print csvField(variant) "," csvField(benchmark) "," csvField(section) "," csvField(label) "," \
+              csvField(metric) "," value
+    }
+    records++
+}
+
+BEGIN {
+    if (format == "") {
+        format = "csv"
+    }
+    if (format == "json") {
+        printf "["
+    } else {
+        print "variant,benchmark,section,label,metric,value"
+    }
+}
+
+FNR == 1 {
+    benchmark = FILENAME
+    sub(/.*\//, "", benchmark)
+    sub(/\.txt$/, "", benchmark)
+}
+
+/^BENCH,/ {
+    sub(/\r$/, "")
+    if (split($0, f, ",") != 5 || f[5] !~ /^-?([0-9]+\.?[0-9]*|\.[0-9]+)([eE][-+]?[0-9]+)?$/) {
+        print FILENAME ":" FNR ": malformed result line: " $0 > "/dev/stderr"
+        failed = 1
+        exit 1
+    }
+    emit(f[2], f[3], f[4], f[5])
+}
+
+END {
+    if (failed) {
+        exit 1
+    }
+    if (format == "json") {
+        print (records > 0 ? "\n]" : "]")
+    }
+}
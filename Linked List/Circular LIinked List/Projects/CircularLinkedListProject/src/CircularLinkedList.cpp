@@ -5,25 +5,84 @@
 Node::Node(int val) : data(val), next(nullptr) {}
 
 // CircularLinkedList constructor
-CircularLinkedList::CircularLinkedList() : head(nullptr) {}
+CircularLinkedList::CircularLinkedList() : tail(nullptr), count(0), cursors(nullptr) {}
+
+// CircularLinkedList destructor
+CircularLinkedList::~CircularLinkedList() {
+    while (deleteAtBeginning()) {
+    }
+    for (RoundRobinCursor* cursor = cursors; cursor != nullptr; cursor = cursor->nextCursor) {
+        cursor->list = nullptr;
+    }
+}
+
+// Function to link a new node between the last and the first node
+void CircularLinkedList::insertBeforeHead(Node* newNode) {
+    if (isEmpty()) {
+        newNode->next = newNode; // Point to itself, forming the circular link
+        tail = newNode;
+    } else {
+        // A cursor whose current node is the first one, or whose current
+        // node was removed and whose next one is the first, now finds it
+        // after the new node.
+        for (RoundRobinCursor* cursor = cursors; cursor != nullptr; cursor = cursor->nextCursor) {
+            if (cursor->prev == tail) {
+                cursor->prev = newNode;
+            }
+        }
+        newNode->next = tail->next;
+        tail->next = newNode;
+    }
+    ++count;
+}
+
+// Function to unlink and delete the node after prev
+void CircularLinkedList::removeAfter(Node* prev) {
+    Node* temp = prev->next;
+    for (RoundRobinCursor* cursor = cursors; cursor != nullptr; cursor = cursor->nextCursor) {
+        if (temp == prev) {
+            // Last node: the cursors start over once something is inserted
+            cursor->prev = nullptr;
+            cursor->hasCurrent = false;
+        } else if (cursor->prev == temp) {
+            cursor->prev = prev;
+        } else if (cursor->prev == prev) {
+            // The cursor's current node is the one going away
+            cursor->hasCurrent = false;
+        }
+    }
+
+    if (temp == prev) {
+        tail = nullptr;
+    } else {
+        prev->next = temp->next;
+        if (temp == tail) {
+            tail = prev;
+        }
+    }
+    delete temp;
+    --count;
+}
+
+// Function to insert a node at the beginning
+void CircularLinkedList::insertAtBeginning(int value) {
+    insertBeforeHead(new Node(value));
+}
 
 // Function to insert a node at the end
 void CircularLinkedList::insertAtEnd(int value) {
     Node* newNode = new Node(value);
-    
+    insertBeforeHead(newNode);
+    tail = newNode;
+}
+
+// Function to delete the first node
+bool CircularLinkedList::deleteAtBeginning() {
     if (isEmpty()) {
-        head = newNode;
-        newNode->next = head; // Point to itself, forming the circular link
-    } else {
-        Node* temp = head;
-        
-        while (temp->next != head) {
-            temp = temp->next;
-        }
-        
-        temp->next = newNode;
-        newNode->next = head; // Complete the circle
+        return false;
     }
+    removeAfter(tail);
+    return true;
 }
 
 // Function to delete a node by value
@@ -32,41 +91,19 @@ void CircularLinkedList::deleteNode(int value) {
         std::cout << "List is empty!" << std::endl;
         return;
     }
-    
-    Node* temp = head;
-    Node* prev = nullptr;
-    
-    if (temp->data == value) {
-        if (temp->next == head) {
-            delete temp;
-            head = nullptr;
-            return;
-        }
 
-        while (temp->next != head) {
-            prev = temp;
-            temp = temp->next;
-        }
-
-        prev->next = head;
-        delete temp;
-        head = head->next;
-    } else {
-        prev = temp;
-        temp = temp->next;
-
-        while (temp != head && temp->data != value) {
-            prev = temp;
-            temp = temp->next;
+    // Walk with the node before the candidate, starting from the last node,
+    // so the first node is unlinked like any other.
+    Node* prev = tail;
+    do {
+        if (prev->next->data == value) {
+            removeAfter(prev);
+            return;
         }
+        prev = prev->next;
+    } while (prev != tail);
 
-        if (temp->data == value) {
-            prev->next = temp->next;
-            delete temp;
-        } else {
-            std::cout << "Node with value " << value << " not found!" << std::endl;
-        }
-    }
+    std::cout << "Node with value " << value << " not found!" << std::endl;
 }
 
 // Function to display the circular linked list
@@ -75,18 +112,18 @@ void CircularLinkedList::display() {
         std::cout << "List is empty!" << std::endl;
         return;
     }
-    
-    Node* temp = head;
+
+    Node* temp = tail->next;
     do {
         std::cout << temp->data << " ";
         temp = temp->next;
-    } while (temp != head);
+    } while (temp != tail->next);
     std::cout << std::endl;
 }
 
 // Function to check if the list is empty
 bool CircularLinkedList::isEmpty() {
-    return head == nullptr;
+    return tail == nullptr;
 }
 
 // Function to search for a value in the list
@@ -94,14 +131,67 @@ bool CircularLinkedList::search(int value) {
     if (isEmpty()) {
         return false;
     }
-    
-    Node* temp = head;
+
+    Node* temp = tail->next;
     do {
         if (temp->data == value) {
             return true;
         }
         temp = temp->next;
-    } while (temp != head);
-    
+    } while (temp != tail->next);
+
     return false;
 }
+
+// Function to get the number of nodes
+std::size_t CircularLinkedList::size() const {
+    return count;
+}
+
+// RoundRobinCursor constructor
+RoundRobinCursor::RoundRobinCursor(CircularLinkedList& list)
+    : list(&list), prev(nullptr), hasCurrent(false), prevCursor(nullptr), nextCursor(list.cursors) {
+    if (nextCursor != nullptr) {
+        nextCursor->prevCursor = this;
+    }
+    list.cursors = this;
+}
+
+// RoundRobinCursor destructor
+RoundRobinCursor::~RoundRobinCursor() {
+    if (list == nullptr) {
+        return;
+    }
+    if (prevCursor != nullptr) {
+        prevCursor->nextCursor = nextCursor;
+    } else {
+        list->cursors = nextCursor;
+    }
+    if (nextCursor != nullptr) {
+        nextCursor->prevCursor = prevCursor;
+    }
+}
+
+// Function to get the next value in round-robin order
+bool RoundRobinCursor::next(int& value) {
+    if (list == nullptr || list->isEmpty()) {
+        return false;
+    }
+    if (prev == nullptr) {
+        prev = list->tail; // Start at the first node
+    } else if (hasCurrent) {
+        prev = prev->next;
+    }
+    hasCurrent = true;
+    value = prev->next->data;
+    return true;
+}
+
+// Function to delete the node returned last
+bool RoundRobinCursor::removeCurrent() {
+    if (list == nullptr || !hasCurrent) {
+        return false;
+    }
+    list->removeAfter(prev);
+    return true;
+}
@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RingBuffer.h"
+#include "../../../../../bench/bench_util.h"
+
+// Producer / consumer hand-off through a bounded queue. Producers push the
+// numbers 1..items between them, consumers pop until all are seen and sum
+// them; a full / empty queue is retried after a yield. Compared:
+//   std::deque + std::mutex   the usual locked queue
+//   SpscRingBuffer            1 producer, 1 consumer
+//   MpmcRingBuffer            1x1 and producers x consumers
+// each one element at a time and in batches of `batch`. Reported: Mitems/s.
+// Checked: every consumer sees each producer's numbers in increasing order
+// (with one consumer, each exactly one more than the last), and together
+// the consumers see exactly 1..items.
+//
+// Latency: one thread sends a counter through an SPSC ring, the other
+// echoes it back through a second one; reported are the median and 99th
+// percentile round trip. With fewer cores than threads every hand-off
+// waits for a context switch, which dominates both numbers.
+//
+// Usage: ./bin/ring_buffer_benchmark [items] [capacity] [threads] [batch]   (default 10000000 1024 2 32)
+
+typedef std::uint64_t Item;
+
+void report(const std::string& label, std::size_t n, double seconds)
+{
+    report(label, {{n / seconds / 1e6, "Mitems/s"}}, 36);
+}
+
+class LockedQueue {
+private:
+    std::mutex lock;
+    std::deque<Item> items;
+    std::size_t limit;
+
+public:
+    explicit LockedQueue(std::size_t capacity) : limit(capacity) {}
+
+    std::size_t pushBatch(const Item* values, std::size_t count)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        std::size_t n = std::min(count, limit - items.size());
+        items.insert(items.end(), values, values + n);
+        return n;
+    }
+
+    std::size_t popBatch(Item* out, std::size_t count)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        std::size_t n = std::min(count, items.size());
+        std::copy(items.begin(), items.begin() + n, out);
+        items.erase(items.begin(), items.begin() + n);
+        return n;
+    }
+};
+
+// Runs producers x consumers threads over queue, moving `batch` items per
+// call. Returns true if the consumers saw exactly 1..items, each producer's
+// items in FIFO order.
+template <typename Queue>
+bool handOff(const std::string& label, Queue& queue, std::size_t items, unsigned producers,
+             unsigned consumers, std::size_t batch)
+{
+    std::vector<Item> sums(consumers, 0);
+    std::vector<std::size_t> counts(consumers, 0);
+    std::vector<char> inOrder(consumers, 1);
+    // Producer p sends firsts[p], firsts[p] + 1, ..., firsts[p + 1] - 1.
+    std::vector<Item> firsts(producers + 1);
+    for (unsigned p = 0; p <= producers; ++p) {
+        firsts[p] = 1 + items * p / producers;
+    }
+    double seconds = timeIt([&]() {
+        std::vector<std::thread> workers;
+        for (unsigned p = 0; p < producers; ++p) {
+            workers.emplace_back([&, p]() {
+                std::vector<Item> values(batch);
+                Item last = firsts[p + 1];
+                for (Item next = firsts[p]; next < last;) {
+                    std::size_t n = std::min<std::size_t>(batch, last - next);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        values[i] = next + i;
+                    }
+                    std::size_t sent = queue.pushBatch(values.data(), n);
+                    if (sent == 0) {
+                        std::this_thread::yield();
+                    }
+                    next += sent;
+                }
+            });
+        }
+        // Consumers stop once all items are taken; the shared count keeps
+        // one consumer from waiting on items another one already popped.
+        std::atomic<std::size_t> taken(0);
+        for (unsigned c = 0; c < consumers; ++c) {
+            workers.emplace_back([&, c]() {
+                std::vector<Item> values(batch);
+                // Last item seen from each producer.
+                std::vector<Item> seen(firsts.begin(), firsts.end() - 1);
+                for (Item& value : seen) {
+                    --value;
+                }
+                bool ordered = true;
+                while (taken.load(std::memory_order_relaxed) < items) {
+                    std::size_t n = queue.popBatch(values.data(), batch);
+                    if (n == 0) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (std::size_t i = 0; i < n; ++i) {
+                        Item value = values[i];
+                        std::size_t p = producers == 1 ? 0
+                                                       : std::upper_bound(firsts.begin(), firsts.end(), value) -
+                                                             firsts.begin() - 1;
+                        ordered = ordered && p < producers &&
+                                  (consumers == 1 ? value == seen[p] + 1 : value > seen[p]);
+                        if (p < producers) {
+                            seen[p] = value;
+                        }
+                        sums[c] += value;
+                    }
+                    counts[c] += n;
+                    taken.fetch_add(n, std::memory_order_relaxed);
+                }
+                inOrder[c] = ordered;
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    });
+    report(label, items, seconds);
+
+    Item sum = 0;
+    std::size_t count = 0;
+    for (unsigned c = 0; c < consumers; ++c) {
+        sum += sums[c];
+        count += counts[c];
+    }
+    bool ordered = std::find(inOrder.begin(), inOrder.end(), 0) == inOrder.end();
+    if (!ordered) {
+        std::cout << "  ^ items out of FIFO order" << std::endl;
+    }
+    return ordered && count == items && sum == (Item)items * (items + 1) / 2;
+}
+
+// Median and 99th percentile round trip over two SPSC rings, in ns.
+bool pingPong(std::size_t rounds)
+{
+    SpscRingBuffer<Item> ping(64), pong(64);
+    std::thread echo([&]() {
+        Item value;
+        for (std::size_t i = 0; i < rounds; ++i) {
+            while (!ping.tryPop(value)) {
+                std::this_thread::yield();
+            }
+            while (!pong.tryPush(value)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<double> trips(rounds);
+    bool ok = true;
+    for (std::size_t i = 0; i < rounds; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        Item value;
+        ping.tryPush(i);
+        while (!pong.tryPop(value)) {
+            std::this_thread::yield();
+        }
+        trips[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        ok = ok && value == i;
+    }
+    echo.join();
+
+    std::sort(trips.begin(), trips.end());
+    report("SPSC ping-pong round trip", {{trips[rounds / 2], "ns p50", 0}, {trips[rounds * 99 / 100], "ns p99", 0}}, 36);
+    return ok;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024;
+    unsigned threads = argc > 3 ? std::atoi(argv[3]) : 2;
+    std::size_t batch = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 32;
+    std::cout << items << " items, capacity " << capacity << ", batch " << batch << ", "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl
+              << std::endl;
+
+    bool ok = true;
+    std::string batched = " x" + std::to_string(batch);
+    std::string wide = " " + std::to_string(threads) + "x" + std::to_string(threads);
+    for (std::size_t n : {(std::size_t)1, batch}) {
+        std::string suffix = n == 1 ? "" : batched;
+        {
+            LockedQueue queue(capacity);
+            ok &= handOff("mutex deque 1x1" + suffix, queue, items, 1, 1, n);
+        }
+        {
+            SpscRingBuffer<Item> queue(capacity);
+            ok &= handOff("SpscRingBuffer 1x1" + suffix, queue, items, 1, 1, n);
+        }
+        {
+            MpmcRingBuffer<Item> queue(capacity);
+            ok &= handOff("MpmcRingBuffer 1x1" + suffix, queue, items, 1, 1, n);
+        }
+        {
+            LockedQueue queue(capacity);
+            ok &= handOff("mutex deque" + wide + suffix, queue, items, threads, threads, n);
+        }
+        {
+            MpmcRingBuffer<Item> queue(capacity);
+            ok &= handOff("MpmcRingBuffer" + wide + suffix, queue, items, threads, threads, n);
+        }
+        std::cout << std::endl;
+    }
+    ok &= pingPong(std::max<std::size_t>(1, std::min<std::size_t>(items / 10, 100000)));
+
+    std::cout << std::endl
+              << "checks: " << (ok ? "ok" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
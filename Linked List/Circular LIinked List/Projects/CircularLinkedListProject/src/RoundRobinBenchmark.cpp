@@ -0,0 +1,147 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "CircularLinkedList.h"
+#include "../../../../../bench/bench_util.h"
+
+// Round-robin dispatch over a ring of backends 0..n-1, for ring sizes from
+// 16 up to `maxBackends`. Reported per size:
+//   build       n calls to insertAtEnd, in ns per insert (constant now that
+//               the list keeps a tail pointer, instead of growing with n)
+//   vector      index round robin over a std::vector, the lower bound
+//   cursor      RoundRobinCursor::next over the CircularLinkedList
+//   cursor+churn the same, but every 64th dispatch the backend just picked
+//               is removed with removeCurrent() and a new one is appended
+// Each dispatch run makes `dispatches` picks (rounded down to whole laps);
+// the checks compare how often each backend was picked, and replay the
+// churn run, untimed, against a std::vector model of the ring to compare
+// the pick order.
+//
+// Usage: ./bin/round_robin_benchmark [dispatches] [maxBackends]   (default 20000000 65536)
+
+void report(const std::string& label, std::size_t n, double seconds)
+{
+    report(label, {{n / seconds / 1e6, "Mops/s"}, {seconds * 1e9 / n, "ns/op"}});
+}
+
+// Replays the cursor+churn run over a fresh ring of n backends and checks
+// every pick against a model: the ring as a vector in order, and the index
+// of the next pick. Removing the current backend leaves the index on its
+// successor, wrapping to the front if it was the last one; appending goes
+// at the end of the vector, which the cursor reaches before it wraps.
+bool matchesModel(std::size_t n, std::size_t picks, std::size_t churnEvery)
+{
+    CircularLinkedList ring;
+    std::vector<int> model;
+    for (std::size_t i = 0; i < n; ++i) {
+        ring.insertAtEnd((int)i);
+        model.push_back((int)i);
+    }
+
+    RoundRobinCursor cursor(ring);
+    std::size_t at = 0;
+    int fresh = (int)n;
+    for (std::size_t i = 0; i < picks; ++i) {
+        int value;
+        if (!cursor.next(value) || value != model[at]) {
+            return false;
+        }
+        if (i % churnEvery == churnEvery - 1) {
+            cursor.removeCurrent();
+            model.erase(model.begin() + at);
+        } else {
+            ++at;
+        }
+        if (at == model.size()) {
+            at = 0;
+        }
+        if (i % churnEvery == churnEvery - 1) {
+            ring.insertAtEnd(fresh);
+            model.push_back(fresh++);
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t dispatches = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+    std::size_t maxBackends = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 65536;
+    std::cout << dispatches << " dispatches per run" << std::endl
+              << std::endl;
+
+    bool ok = true;
+    for (std::size_t n = 16; n <= maxBackends; n *= 16) {
+        std::size_t laps = dispatches / n > 0 ? dispatches / n : 1;
+        std::size_t picks = laps * n;
+        std::uint64_t expected = (std::uint64_t)laps * n * (n - 1) / 2;
+        benchSection(std::to_string(n) + " backends");
+
+        CircularLinkedList ring;
+        report("  build", n, timeIt([&]() {
+                   for (std::size_t i = 0; i < n; ++i) {
+                       ring.insertAtEnd((int)i);
+                   }
+               }));
+
+        std::vector<int> backends(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            backends[i] = (int)i;
+        }
+        std::uint64_t sum = 0;
+        report("  vector", picks, timeIt([&]() {
+                   std::size_t at = 0;
+                   for (std::size_t i = 0; i < picks; ++i) {
+                       sum += backends[at];
+                       if (++at == n) {
+                           at = 0;
+                       }
+                   }
+               }));
+        ok &= sum == expected;
+
+        sum = 0;
+        {
+            RoundRobinCursor cursor(ring);
+            report("  cursor", picks, timeIt([&]() {
+                       int value;
+                       for (std::size_t i = 0; i < picks; ++i) {
+                           cursor.next(value);
+                           sum += value;
+                       }
+                   }));
+        }
+        ok &= sum == expected;
+
+        // Replacing a backend keeps the ring size at n, so every backend
+        // alive at the end has been picked at most laps + 1 times.
+        std::vector<std::uint32_t> picked(n + picks / 64 + 1, 0);
+        {
+            RoundRobinCursor cursor(ring);
+            int fresh = (int)n;
+            report("  cursor+churn", picks, timeIt([&]() {
+                       int value;
+                       for (std::size_t i = 0; i < picks; ++i) {
+                           cursor.next(value);
+                           ++picked[value];
+                           if (i % 64 == 63) {
+                               cursor.removeCurrent();
+                               ring.insertAtEnd(fresh++);
+                           }
+                       }
+                   }));
+        }
+        for (std::uint32_t count : picked) {
+            ok &= count <= laps + 1;
+        }
+        ok &= ring.size() == n;
+        ok &= matchesModel(n, picks < 4 * n ? picks : 4 * n, 64);
+        ok &= matchesModel(n, 4 * n, 3);
+        std::cout << std::endl;
+    }
+
+    std::cout << "checks: " << (ok ? "ok" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
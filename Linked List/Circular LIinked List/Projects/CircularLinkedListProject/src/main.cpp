@@ -19,6 +19,27 @@ int main() {
     cll.display();
     
     cll.deleteNode(100);
-    
+
+    cll.insertAtBeginning(5);
+    std::cout << "After inserting 5 at the beginning: ";
+    cll.display();
+
+    // Round-robin dispatch: the cursor keeps its place while nodes come and go
+    RoundRobinCursor cursor(cll);
+    int value;
+    std::cout << "Round robin: ";
+    for (int i = 0; i < 6; i++) {
+        cursor.next(value);
+        std::cout << value << " ";
+    }
+    std::cout << std::endl;
+
+    cursor.removeCurrent();
+    cll.deleteAtBeginning();
+    std::cout << "After removing the current node and the first node: ";
+    cll.display();
+    cursor.next(value);
+    std::cout << "Round robin continues with: " << value << std::endl;
+
     return 0;
 }
@@ -12,93 +12,113 @@ struct Node
     }
 };
 
+// Only the last node is stored; the first one is tail->next. That puts both
+// ends one step away, so inserting at either end and deleting the first
+// node are O(1) instead of a walk around the ring.
 class CircularLinkedList
 {
 private:
-    Node *head;
+    Node *tail;
+
+    // Unlinks and deletes the node after prev.
+    void removeAfter(Node *prev);
 
 public:
-    CircularLinkedList() : head(nullptr) {}
-    void insertAtEndf(int value);
+    CircularLinkedList() : tail(nullptr) {}
+    ~CircularLinkedList();
+    CircularLinkedList(const CircularLinkedList &) = delete;
+    CircularLinkedList &operator=(const CircularLinkedList &) = delete;
+
+    void insertAtBeginning(int value);
+    void insertAtEnd(int value);
+    bool deleteAtBeginning();
     void deleteNode(int value);
     void display();
     bool isEmpty()
     {
-        return head == nullptr;
+        return tail == nullptr;
     }
     bool search(int value);
 };
 
-void CircularLinkedList::insertAtEndf(int value)
+CircularLinkedList::~CircularLinkedList()
 {
-    Node *newNode = new Node(value);
-    if (isEmpty())
+    while (deleteAtBeginning())
     {
-        head = newNode;
-        newNode->next = head;
+    }
+}
+
+void CircularLinkedList::removeAfter(Node *prev)
+{
+    Node *temp = prev->next;
+    if (temp == prev)
+    {
+        tail = nullptr;
     }
     else
     {
-        Node *temp = head;
-        while (temp->next != head)
+        prev->next = temp->next;
+        if (temp == tail)
         {
-            temp = temp->next;
+            tail = prev;
         }
-        temp->next = newNode;
-        newNode->next = head;
     }
+    delete temp;
 }
 
-void CircularLinkedList::deleteNode(int value)
+void CircularLinkedList::insertAtBeginning(int value)
 {
+    Node *newNode = new Node(value);
     if (isEmpty())
     {
-        cout << "List is empty!" << endl;
-        return;
+        newNode->next = newNode;
+        tail = newNode;
     }
+    else
+    {
+        newNode->next = tail->next;
+        tail->next = newNode;
+    }
+}
 
-    Node *temp = head;
-    Node *prev = nullptr;
+void CircularLinkedList::insertAtEnd(int value)
+{
+    // The new node goes in front of the first one and becomes the tail.
+    insertAtBeginning(value);
+    tail = tail->next;
+}
 
-    if (temp->data == value)
+bool CircularLinkedList::deleteAtBeginning()
+{
+    if (isEmpty())
     {
-        if (temp->next == head)
-        {
-            delete temp;
-            head = nullptr;
-            return;
-        }
-
-        while (temp->next != head)
-        {
-            prev = temp;
-            temp = temp->next;
-        }
+        return false;
+    }
+    removeAfter(tail);
+    return true;
+}
 
-        prev->next = head;
-        delete temp;
-        head = head->next;
+void CircularLinkedList::deleteNode(int value)
+{
+    if (isEmpty())
+    {
+        cout << "List is empty!" << endl;
+        return;
     }
-    else
+
+    // Starting from the tail, the first node is unlinked like any other.
+    Node *prev = tail;
+    do
     {
-        prev = temp;
-        temp = temp->next;
-        while (temp != head && temp->data != value)
+        if (prev->next->data == value)
         {
-            prev = temp;
-            temp = temp->next;
+            removeAfter(prev);
+            return;
         }
+        prev = prev->next;
+    } while (prev != tail);
 
-        if (temp->data == value)
-        {
-            prev->next = temp->next;
-            delete temp;
-        }
-        else
-        {
-            cout << "Node with value " << value;
-        }
-    }
+    cout << "Node with value " << value << " not found!" << endl;
 }
 
 void CircularLinkedList::display()
@@ -109,12 +129,12 @@ void CircularLinkedList::display()
         return;
     }
 
-    Node *temp = head;
+    Node *temp = tail->next;
     do
     {
         cout << temp->data << " ";
         temp = temp->next;
-    } while (temp != head);
+    } while (temp != tail->next);
 
     cout << endl;
 }
@@ -126,7 +146,7 @@ bool CircularLinkedList::search(int value)
         return false;
     }
 
-    Node *temp = head;
+    Node *temp = tail->next;
     do
     {
         if (temp->data == value)
@@ -134,26 +154,34 @@ bool CircularLinkedList::search(int value)
             return true;
         }
         temp = temp->next;
-    } while (temp != head);
+    } while (temp != tail->next);
 
     return false;
 }
 int main()
 {
     CircularLinkedList cll;
-    cll.insertAtEndf(10);
-    cll.insertAtEndf(20);
-    cll.insertAtEndf(30);
-    cll.insertAtEndf(40);
+    cll.insertAtEnd(10);
+    cll.insertAtEnd(20);
+    cll.insertAtEnd(30);
+    cll.insertAtEnd(40);
 
     cout << "Circular linked list: ";
     cll.display();
 
-    cout << "Searching for 20: " << (cll.search(20) ? "Found!" : "Not found!");
+    cout << "Searching for 20: " << (cll.search(20) ? "Found!" : "Not found!") << endl;
 
     cll.deleteNode(30);
     cout << "After deleting 30: ";
     cll.display();
+
+    cll.insertAtBeginning(5);
+    cll.deleteNode(10);
+    cout << "After inserting 5 and deleting 10: ";
+    cll.display();
+
+    cll.deleteAtBeginning();
+    cout << "After deleting the first node: ";
     cll.display();
     return 0;
-}
\ No newline at end of file
+}
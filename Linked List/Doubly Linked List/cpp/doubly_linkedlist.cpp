@@ -22,6 +22,8 @@ private:
 public:
     DoublyLinkedList();
     ~DoublyLinkedList();
+    DoublyLinkedList(const DoublyLinkedList &) = delete;
+    DoublyLinkedList &operator=(const DoublyLinkedList &) = delete;
 
     void insertAtBeginning(int value)
     {
@@ -67,7 +69,6 @@ public:
             return;
         }
 
-        Node *newNode = new Node(value);
         Node *temp = head;
 
         int count = 1;
@@ -76,7 +77,20 @@ public:
             temp = temp->next;
             count++;
         }
+        if (!temp)
+        {
+            if (count == position)
+            {
+                insertAtEnd(value); // one past the last node
+            }
+            else
+            {
+                cout << "Position out of range!" << endl;
+            }
+            return;
+        }
 
+        Node *newNode = new Node(value);
         newNode->next = temp;
         newNode->prev = temp->prev;
         if (temp->prev)
@@ -160,6 +174,10 @@ public:
         {
             temp->next->prev = temp->prev;
         }
+        else
+        {
+            tail = temp->prev;
+        }
         delete temp;
     }
     void forwardTraversal()
@@ -190,6 +208,12 @@ DoublyLinkedList::DoublyLinkedList() : head(nullptr), tail(nullptr)
 
 DoublyLinkedList::~DoublyLinkedList()
 {
+    while (head)
+    {
+        Node *temp = head;
+        head = head->next;
+        delete temp;
+    }
 }
 
 int main()
@@ -0,0 +1,190 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdlib>
+#include "history_buffer.h"
+#include "../../../bench/bench_util.h"
+
+using namespace std;
+
+// Undo / redo history of int states, capacity `capacity`, two ways:
+//   pointer list   one heap node per action with prev / next pointers, as in
+//                  Applications/history.md and doubly_linkedlist.cpp, plus a
+//                  count so the oldest can be evicted; positions are found by
+//                  walking from the oldest
+//   HistoryBuffer  slab + 32-bit links + Fenwick positions
+// Workloads, on a history kept full:
+//   edit     `ops` steps: mostly push, with occasional undo bursts of up to
+//            16 steps (so the next push drops redo entries)
+//   navigate `ops` random back / forward steps
+//   seek     random at(position) lookups (`seeks` of them; the pointer list
+//            walks, so it gets fewer), and for HistoryBuffer again after
+//            erasing an entry from the middle
+//
+// Usage: ./historyBenchmark [capacity] [ops] [seeks]   (default 1000000 20000000 1000000)
+
+class PointerHistory
+{
+private:
+    struct Action
+    {
+        int state;
+        Action *prev;
+        Action *next;
+
+        Action(int state) : state(state), prev(nullptr), next(nullptr) {}
+    };
+
+    Action *oldest = nullptr;
+    Action *current = nullptr;
+    size_t count = 0;
+    size_t capacity;
+
+public:
+    explicit PointerHistory(size_t capacity) : capacity(capacity) {}
+    ~PointerHistory()
+    {
+        while (oldest)
+        {
+            Action *temp = oldest;
+            oldest = oldest->next;
+            delete temp;
+        }
+    }
+
+    void push(int state)
+    {
+        if (current)
+        {
+            while (current->next)
+            {
+                Action *temp = current->next;
+                current->next = temp->next;
+                delete temp;
+                count--;
+            }
+        }
+        Action *action = new Action(state);
+        action->prev = current;
+        if (current)
+            current->next = action;
+        else
+            oldest = action;
+        current = action;
+        if (++count > capacity)
+        {
+            Action *temp = oldest;
+            oldest = oldest->next;
+            oldest->prev = nullptr;
+            delete temp;
+            count--;
+        }
+    }
+    bool back()
+    {
+        if (!current || !current->prev)
+            return false;
+        current = current->prev;
+        return true;
+    }
+    bool forward()
+    {
+        if (!current || !current->next)
+            return false;
+        current = current->next;
+        return true;
+    }
+    int at(size_t position) const
+    {
+        Action *temp = oldest;
+        while (position--)
+            temp = temp->next;
+        return temp->state;
+    }
+    int state() const { return current->state; }
+    size_t size() const { return count; }
+};
+
+void report(const string &label, size_t n, double seconds)
+{
+    report(label, {{seconds * 1e9 / n, "ns/op"}}, 40);
+}
+
+template <typename History>
+long long run(const string &name, History &history, size_t capacity, size_t ops)
+{
+    long long checksum = 0;
+    mt19937 rng(3);
+    for (size_t i = 0; i < capacity; i++)
+        history.push((int)i);
+
+    report(name + " edit", ops, timeIt([&]()
+                                       {
+        for (size_t i = 0; i < ops; i++)
+        {
+            if (rng() % 64 == 0)
+            {
+                for (unsigned k = rng() % 16; k > 0; k--)
+                    history.back();
+            }
+            else
+                history.push((int)i);
+        } }));
+    report(name + " navigate", ops, timeIt([&]()
+                                           {
+        for (size_t i = 0; i < ops; i++)
+        {
+            if (rng() & 1)
+                history.back();
+            else
+                history.forward();
+            checksum += history.state();
+        } }));
+    return checksum;
+}
+
+template <typename History>
+long long seek(const string &name, const History &history, size_t seeks)
+{
+    long long checksum = 0;
+    mt19937 rng(4);
+    size_t size = history.size();
+    report(name + " seek x" + to_string(seeks), seeks, timeIt([&]()
+                                         {
+        for (size_t i = 0; i < seeks; i++)
+            checksum += history.at(rng() % size); }));
+    return checksum;
+}
+
+// HistoryBuffer with the pointer list's spelling of current().
+struct SlabHistory : HistoryBuffer<int>
+{
+    explicit SlabHistory(uint32_t capacity) : HistoryBuffer<int>(capacity) {}
+    int state() const { return current(); }
+};
+
+int main(int argc, char *argv[])
+{
+    size_t capacity = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t ops = argc > 2 ? strtoull(argv[2], nullptr, 10) : 20000000;
+    size_t seeks = argc > 3 ? strtoull(argv[3], nullptr, 10) : 1000000;
+    size_t pointerSeeks = max<size_t>(1, seeks / 1000);
+    cout << "capacity " << capacity << endl;
+
+    PointerHistory pointers(capacity);
+    long long a = run("pointer list", pointers, capacity, ops);
+    long long aSeek = seek("pointer list", pointers, pointerSeeks);
+    cout << endl;
+    SlabHistory slab((uint32_t)capacity);
+    long long b = run("HistoryBuffer", slab, capacity, ops);
+    long long bSeek = seek("HistoryBuffer", slab, pointerSeeks);
+    seek("HistoryBuffer", slab, seeks);
+    // A hole in the middle switches positions to the Fenwick tree.
+    slab.erase(slab.size() / 2);
+    seek("HistoryBuffer after erase", slab, seeks);
+
+    bool ok = a == b && aSeek == bSeek && pointers.size() == slab.size() + 1 && pointers.state() == slab.state();
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,346 @@
+#ifndef HISTORY_BUFFER_H
+#define HISTORY_BUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Bounded undo / redo history: a doubly linked list whose nodes live in one
+// slab and link to each other by 32-bit indices.
+//
+// The entries run from oldest to newest with a cursor on the current one.
+// push() drops everything after the cursor (the redo entries), appends the
+// new state and makes it current; once `capacity` entries are held, the
+// oldest is evicted. back() / forward() move the cursor one entry. All of
+// these are O(1) (dropping redo entries is O(1) per dropped entry).
+//
+// Every entry gets the next sequence number when it is pushed. While
+// entries only come and go at the ends, the numbers of the live entries are
+// contiguous and a position (0 = oldest) is a subtraction, O(1). erase()
+// can remove an entry from the middle (e.g. deleting a page from browser
+// history) and leave a hole; from then on positions are answered in
+// O(log n) by a Fenwick tree over the numbers, whose node k counts the live
+// entries among the 2^j numbers ending at k, like the express lanes of an
+// indexable skip list. That covers at(), position() and jumpTo().
+//
+// Nodes are 32-bit indices into a vector sized to the capacity up front, so
+// the buffer never allocates after construction and the links stay valid
+// when the slab is copied. Each unit of capacity costs sizeof(T) + 12 bytes
+// of node (before padding to T's alignment) plus 16 to 32 bytes of ring:
+// ringEntry and fenwick hold one 32-bit word each per ring slot, and the
+// ring has 2 to 4 slots per unit. That is about sizeof(T) + 28 to 44 bytes.
+template <typename T>
+class HistoryBuffer
+{
+private:
+    static constexpr std::uint32_t kNil = 0xFFFFFFFFu;
+
+    struct Entry
+    {
+        T value;
+        std::uint32_t prev;
+        std::uint32_t next;
+        std::uint32_t seq;
+    };
+
+    std::vector<Entry> slab;
+    std::uint32_t freeList = kNil; // through Entry::next
+    std::uint32_t used = 0;        // slab entries handed out at least once
+    std::uint32_t oldest = kNil;
+    std::uint32_t newest = kNil;
+    std::uint32_t cursor = kNil;
+    std::uint32_t count = 0;
+    std::uint32_t limit;
+
+    // Sequence numbers live on a ring of ringSize >= 2 * capacity slots;
+    // ringEntry maps a slot back to its slab index. fenwick counts live
+    // entries per slot, and is only kept up to date while the numbering has
+    // holes (dense == false). Holes let the numbers spread out; when they
+    // would wrap onto live entries, they are reassigned from 0, which also
+    // removes the holes (O(n), at most once per `capacity` pushes).
+    std::uint32_t ringSize;
+    std::vector<std::uint32_t> fenwick;
+    std::vector<std::uint32_t> ringEntry;
+    std::uint32_t nextSeq = 0;
+    bool dense = true;
+
+    std::uint32_t ringSlot(std::uint32_t seq) const { return seq & (ringSize - 1); }
+
+    void fenwickAdd(std::uint32_t slot, int delta)
+    {
+        for (std::uint32_t i = slot + 1; i <= ringSize; i += i & (0u - i))
+        {
+            fenwick[i - 1] += delta;
+        }
+    }
+
+    // Live entries in ring slots [0, slot).
+    std::uint32_t fenwickPrefix(std::uint32_t slot) const
+    {
+        std::uint32_t sum = 0;
+        for (std::uint32_t i = slot; i > 0; i -= i & (0u - i))
+        {
+            sum += fenwick[i - 1];
+        }
+        return sum;
+    }
+
+    // Ring slot of the k-th (0-based) live entry in slot order.
+    std::uint32_t fenwickSelect(std::uint32_t k) const
+    {
+        std::uint32_t slot = 0;
+        for (std::uint32_t step = ringSize; step > 0; step >>= 1)
+        {
+            if (slot + step <= ringSize && fenwick[slot + step - 1] <= k)
+            {
+                slot += step;
+                k -= fenwick[slot - 1];
+            }
+        }
+        return slot;
+    }
+
+    // Live entries in ring slots from the oldest entry's slot up to the end
+    // of the ring; the rest have wrapped around to the front.
+    std::uint32_t liveFromOldestToRingEnd() const { return count - fenwickPrefix(ringSlot(slab[oldest].seq)); }
+
+    std::uint32_t entryAt(std::size_t position) const
+    {
+        if (dense)
+        {
+            return ringEntry[ringSlot(slab[oldest].seq + (std::uint32_t)position)];
+        }
+        std::uint32_t beforeOldest = fenwickPrefix(ringSlot(slab[oldest].seq));
+        std::uint32_t tailPart = count - beforeOldest;
+        std::uint32_t k = position < tailPart ? beforeOldest + (std::uint32_t)position : (std::uint32_t)position - tailPart;
+        return ringEntry[fenwickSelect(k)];
+    }
+
+    std::size_t positionOf(std::uint32_t index) const
+    {
+        if (dense)
+        {
+            return slab[index].seq - slab[oldest].seq;
+        }
+        std::uint32_t from = ringSlot(slab[oldest].seq);
+        std::uint32_t slot = ringSlot(slab[index].seq);
+        return slot >= from ? fenwickPrefix(slot) - fenwickPrefix(from)
+                            : liveFromOldestToRingEnd() + fenwickPrefix(slot);
+    }
+
+    void renumber()
+    {
+        nextSeq = 0;
+        for (std::uint32_t i = oldest; i != kNil; i = slab[i].next)
+        {
+            slab[i].seq = nextSeq++;
+            ringEntry[ringSlot(slab[i].seq)] = i;
+        }
+        dense = true;
+    }
+
+    // Switches to counted positions before the first hole is made. O(ring
+    // size), with a linear Fenwick build: each node passes its count to its
+    // parent.
+    void buildFenwick()
+    {
+        std::fill(fenwick.begin(), fenwick.end(), 0);
+        for (std::uint32_t i = oldest; i != kNil; i = slab[i].next)
+        {
+            fenwick[ringSlot(slab[i].seq)] = 1;
+        }
+        for (std::uint32_t i = 1; i <= ringSize; ++i)
+        {
+            std::uint32_t parent = i + (i & (0u - i));
+            if (parent <= ringSize)
+            {
+                fenwick[parent - 1] += fenwick[i - 1];
+            }
+        }
+        dense = false;
+    }
+
+    std::uint32_t takeEntry()
+    {
+        if (freeList != kNil)
+        {
+            std::uint32_t index = freeList;
+            freeList = slab[index].next;
+            return index;
+        }
+        return used++;
+    }
+
+    // Unlinks entry `index` and returns it to the free list.
+    void remove(std::uint32_t index)
+    {
+        Entry &entry = slab[index];
+        (entry.prev != kNil ? slab[entry.prev].next : oldest) = entry.next;
+        (entry.next != kNil ? slab[entry.next].prev : newest) = entry.prev;
+        if (!dense)
+        {
+            fenwickAdd(ringSlot(entry.seq), -1);
+        }
+        entry.value = T();
+        entry.next = freeList;
+        freeList = index;
+        --count;
+    }
+
+public:
+    explicit HistoryBuffer(std::uint32_t capacity) : limit(capacity)
+    {
+        if (capacity == 0 || capacity > 0x40000000u)
+        {
+            throw std::invalid_argument("HistoryBuffer: capacity must be in 1..2^30");
+        }
+        slab.resize(capacity);
+        ringSize = 2;
+        while (ringSize < 2 * capacity)
+        {
+            ringSize *= 2;
+        }
+        fenwick.assign(ringSize, 0);
+        ringEntry.assign(ringSize, kNil);
+    }
+
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return limit; }
+    bool empty() const { return count == 0; }
+    bool canGoBack() const { return cursor != kNil && slab[cursor].prev != kNil; }
+    bool canGoForward() const { return cursor != kNil && slab[cursor].next != kNil; }
+
+    // The current state. The buffer must not be empty.
+    const T &current() const { return slab[cursor].value; }
+
+    // Makes state the newest entry and the current one, dropping the redo
+    // entries and, if the buffer is full, the oldest entry.
+    void push(T state)
+    {
+        while (cursor != newest)
+        {
+            remove(newest);
+        }
+        // Numbers after the cursor are all free again.
+        nextSeq = cursor != kNil ? slab[cursor].seq + 1 : 0;
+        if (count == limit)
+        {
+            remove(oldest);
+        }
+        if (count > 0 && nextSeq - slab[oldest].seq >= ringSize)
+        {
+            renumber();
+        }
+
+        std::uint32_t index = takeEntry();
+        Entry &entry = slab[index];
+        entry.value = std::move(state);
+        entry.prev = newest;
+        entry.next = kNil;
+        entry.seq = nextSeq++;
+        (newest != kNil ? slab[newest].next : oldest) = index;
+        newest = index;
+        cursor = index;
+        ringEntry[ringSlot(entry.seq)] = index;
+        if (!dense)
+        {
+            fenwickAdd(ringSlot(entry.seq), 1);
+        }
+        ++count;
+    }
+
+    // Undo: moves to the previous entry. Returns false at the oldest.
+    bool back()
+    {
+        if (!canGoBack())
+        {
+            return false;
+        }
+        cursor = slab[cursor].prev;
+        return true;
+    }
+
+    // Redo: moves to the next entry. Returns false at the newest.
+    bool forward()
+    {
+        if (!canGoForward())
+        {
+            return false;
+        }
+        cursor = slab[cursor].next;
+        return true;
+    }
+
+    // Entry at position (0 = oldest), O(log n). Throws std::out_of_range.
+    const T &at(std::size_t position) const
+    {
+        if (position >= count)
+        {
+            throw std::out_of_range("HistoryBuffer::at");
+        }
+        return slab[entryAt(position)].value;
+    }
+
+    // Position of the current entry, O(log n). The buffer must not be empty.
+    std::size_t position() const { return positionOf(cursor); }
+
+    // Makes the entry at position current, keeping the entries after it for
+    // redo. Returns false if position is out of range.
+    bool jumpTo(std::size_t position)
+    {
+        if (position >= count)
+        {
+            return false;
+        }
+        cursor = entryAt(position);
+        return true;
+    }
+
+    // Removes the entry at position. If it was current, the cursor moves to
+    // the entry before it (or after it, if it was the oldest). Returns false
+    // if position is out of range.
+    bool erase(std::size_t position)
+    {
+        if (position >= count)
+        {
+            return false;
+        }
+        std::uint32_t index = entryAt(position);
+        if (dense && index != oldest && index != newest)
+        {
+            buildFenwick();
+        }
+        if (index == cursor)
+        {
+            cursor = slab[index].prev != kNil ? slab[index].prev : slab[index].next;
+        }
+        remove(index);
+        return true;
+    }
+
+    void clear()
+    {
+        while (newest != kNil)
+        {
+            remove(newest);
+        }
+        cursor = kNil;
+        nextSeq = 0;
+        dense = true;
+    }
+
+    // Calls visit(state, isCurrent) from oldest to newest.
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (std::uint32_t i = oldest; i != kNil; i = slab[i].next)
+        {
+            visit(slab[i].value, i == cursor);
+        }
+    }
+};
+
+#endif // HISTORY_BUFFER_H
@@ -1,4 +1,125 @@
 #include <iostream>
+#include <string>
+#include "history_buffer.h"
 
 using namespace std;
 
+// Editor / browser history from Applications/history.md, on HistoryBuffer:
+// a bounded slab-backed doubly linked list instead of one heap node per
+// action, so undo / redo are O(1), old actions fall off the end instead of
+// piling up, and any entry can be reached by position in O(log n).
+class HistoryManager
+{
+private:
+    HistoryBuffer<string> history;
+
+public:
+    explicit HistoryManager(uint32_t maxActions) : history(maxActions) {}
+
+    // Perform a new action; any redo history is discarded.
+    void performAction(const string &action)
+    {
+        history.push(action);
+        cout << "Performed Action: " << action << endl;
+    }
+
+    void undo()
+    {
+        if (history.empty() || !history.canGoBack())
+        {
+            cout << "No actions to undo." << endl;
+            return;
+        }
+        cout << "Undoing Action: " << history.current() << endl;
+        history.back();
+    }
+
+    void redo()
+    {
+        if (!history.forward())
+        {
+            cout << "No actions to redo." << endl;
+            return;
+        }
+        cout << "Redoing Action: " << history.current() << endl;
+    }
+
+    // Jump straight to the n-th remembered action (0 = oldest).
+    void goTo(size_t position)
+    {
+        if (!history.jumpTo(position))
+        {
+            cout << "No action at position " << position << "." << endl;
+            return;
+        }
+        cout << "Jumped to: " << history.current() << endl;
+    }
+
+    // Forget one action, e.g. a page removed from browser history.
+    void forget(size_t position)
+    {
+        if (!history.erase(position))
+        {
+            cout << "No action at position " << position << "." << endl;
+        }
+    }
+
+    void displayCurrentState()
+    {
+        if (history.empty())
+        {
+            cout << "No actions performed yet." << endl;
+            return;
+        }
+        cout << "Current Document State: " << history.current()
+             << " (" << history.position() + 1 << " of " << history.size() << ")" << endl;
+    }
+
+    void displayHistory()
+    {
+        history.forEach([](const string &action, bool isCurrent)
+                        { cout << (isCurrent ? " > " : "   ") << action << endl; });
+    }
+
+    void clearHistory()
+    {
+        history.clear();
+        cout << "History cleared!" << endl;
+    }
+};
+
+int main()
+{
+    // Remembers the last 4 actions.
+    HistoryManager manager(4);
+
+    manager.performAction("Action 1: Text Added");
+    manager.performAction("Action 2: Text Deleted");
+    manager.performAction("Action 3: Text Modified");
+    manager.displayCurrentState();
+
+    manager.undo();
+    manager.undo();
+    manager.displayCurrentState();
+
+    manager.redo();
+    manager.displayCurrentState();
+
+    // A new action after undoing discards the redo history.
+    manager.performAction("Action 4: New Text Added");
+    manager.redo();
+
+    // Past the capacity the oldest actions are evicted.
+    manager.performAction("Action 5: Formatting");
+    manager.performAction("Action 6: Image Inserted");
+    manager.displayHistory();
+
+    manager.goTo(1);
+    manager.displayCurrentState();
+    manager.forget(0);
+    manager.displayHistory();
+
+    manager.clearHistory();
+    manager.displayCurrentState();
+    return 0;
+}
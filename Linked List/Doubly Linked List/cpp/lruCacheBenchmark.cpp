@@ -0,0 +1,272 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "lru_cache.h"
+#include "../../../bench/bench_util.h"
+
+using namespace std;
+
+// Read-through caches over Zipfian key traces: every access is a get, and
+// a miss puts the key. Compared:
+//   std::list + unordered_map   the hand-rolled LRU (two allocations per
+//                               entry)
+//   LruCache / SlruCache        intrusive, slab-backed (lru_cache.h)
+// Traces draw `ops` keys from `keys` distinct ones with Zipf exponents 0.8,
+// 0.99 and 1.2, plus a 0.99 trace interrupted by scans: every 100k accesses
+// a run of `capacity` one-off keys. Reported: hit ratio and single-thread
+// Mops/s. Then the 0.99 trace replayed by `threads` threads against one
+// mutex-guarded LruCache and against ShardedCache. The checks make sure
+// LruCache and SlruCache allocate nothing after construction (global
+// operator new is counted), that LruCache hits on exactly the accesses the
+// std::list LRU hits on (both are exact LRU), and that a stateful hasher
+// given to ShardedCache reaches the shards' own tables.
+//
+// Usage: ./lruCacheBenchmark [keys] [capacity] [ops] [threads]   (default 1000000 50000 10000000 hardware threads)
+
+// Calls of the global operator new, i.e. every allocation of the caches and
+// their FlatHashMap slot arrays. The replacements are kept out of line so
+// GCC does not pair an inlined free() with a new expression and warn.
+atomic<size_t> allocations(0);
+
+__attribute__((noinline)) void *operator new(size_t bytes)
+{
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void *p = malloc(bytes ? bytes : 1))
+        return p;
+    throw bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept { free(p); }
+
+// Counts its calls when given a counter; a default-constructed copy, as a
+// shard would get if the caller's hasher were dropped, does not.
+struct CountingHash
+{
+    size_t *calls = nullptr;
+
+    uint64_t operator()(uint64_t key) const
+    {
+        if (calls != nullptr)
+            ++*calls;
+        return key * 0x9E3779B97F4A7C15ull;
+    }
+};
+
+class StdLru
+{
+private:
+    size_t capacity;
+    list<pair<uint64_t, uint64_t>> entries;
+    unordered_map<uint64_t, list<pair<uint64_t, uint64_t>>::iterator> index;
+
+public:
+    explicit StdLru(size_t capacity) : capacity(capacity) { index.reserve(capacity); }
+
+    uint64_t *get(uint64_t key)
+    {
+        auto found = index.find(key);
+        if (found == index.end())
+            return nullptr;
+        entries.splice(entries.begin(), entries, found->second);
+        return &found->second->second;
+    }
+    void put(uint64_t key, uint64_t value)
+    {
+        if (entries.size() == capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+        entries.emplace_front(key, value);
+        index[key] = entries.begin();
+    }
+};
+
+vector<uint64_t> zipfTrace(size_t keys, size_t ops, double exponent, bool scans, size_t scanLength, uint64_t seed)
+{
+    vector<double> cdf(keys);
+    double sum = 0;
+    for (size_t i = 0; i < keys; i++)
+    {
+        sum += 1.0 / pow((double)(i + 1), exponent);
+        cdf[i] = sum;
+    }
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> uniform(0, sum);
+    vector<uint64_t> trace(ops);
+    uint64_t coldKey = keys;
+    for (size_t i = 0; i < ops; i++)
+    {
+        uint64_t rank;
+        if (scans && i % 100000 >= 100000 - scanLength)
+            rank = coldKey++;
+        else
+            rank = lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+        trace[i] = rank * 0x9E3779B97F4A7C15ull; // spread ranks over the key space
+    }
+    return trace;
+}
+
+void report(const string &label, size_t hits, size_t n, double seconds)
+{
+    report(label, {{100.0 * hits / n, "% hits"}, {n / seconds / 1e6, "Mops/s"}}, 34);
+}
+
+template <typename Cache>
+size_t replay(Cache &cache, const vector<uint64_t> &trace)
+{
+    size_t hits = 0;
+    for (uint64_t key : trace)
+    {
+        if (cache.get(key) != nullptr)
+            hits++;
+        else
+            cache.put(key, key);
+    }
+    return hits;
+}
+
+struct Replay
+{
+    size_t hits;
+    size_t allocations; // made during the replay
+};
+
+template <typename Cache>
+Replay single(const string &label, size_t capacity, const vector<uint64_t> &trace)
+{
+    Cache cache(capacity);
+    size_t hits = 0;
+    size_t before = allocations.load();
+    double seconds = timeIt([&]()
+                            { hits = replay(cache, trace); });
+    size_t allocated = allocations.load() - before;
+    report(label, hits, trace.size(), seconds);
+    return {hits, allocated};
+}
+
+// Each thread replays its own slice; get / put go through Access.
+template <typename Access>
+void threaded(const string &label, const vector<uint64_t> &trace, unsigned threads, Access access)
+{
+    vector<size_t> hits(threads);
+    double seconds = timeIt([&]()
+                            {
+        vector<thread> workers;
+        size_t slice = trace.size() / threads;
+        for (unsigned t = 0; t < threads; t++)
+            workers.emplace_back([&, t]()
+                                 {
+                for (size_t i = t * slice; i < (t + 1) * slice; i++)
+                    hits[t] += access(trace[i]); });
+        for (thread &worker : workers)
+            worker.join(); });
+    size_t total = 0;
+    for (size_t h : hits)
+        total += h;
+    report(label, total, trace.size() / threads * threads, seconds);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t keys = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t capacity = argc > 2 ? strtoull(argv[2], nullptr, 10) : 50000;
+    size_t ops = argc > 3 ? strtoull(argv[3], nullptr, 10) : 10000000;
+    unsigned threads = argc > 4 ? atoi(argv[4]) : max(1u, thread::hardware_concurrency());
+    cout << keys << " keys, capacity " << capacity << ", " << ops << " accesses" << endl
+         << endl;
+
+    struct Workload
+    {
+        string name;
+        double exponent;
+        bool scans;
+    } workloads[] = {{"zipf 0.8", 0.8, false}, {"zipf 0.99", 0.99, false}, {"zipf 1.2", 1.2, false}, {"zipf 0.99 + scans", 0.99, true}};
+    vector<uint64_t> zipf99;
+    size_t slabAllocations = 0;
+    bool sameHits = true;
+    for (const Workload &w : workloads)
+    {
+        vector<uint64_t> trace = zipfTrace(keys, ops, w.exponent, w.scans, min<size_t>(capacity, 50000), 1);
+        benchSection(w.name);
+        Replay reference = single<StdLru>("  std::list + unordered_map", capacity, trace);
+        Replay lru = single<LruCache<uint64_t, uint64_t>>("  LruCache", capacity, trace);
+        Replay slru = single<SlruCache<uint64_t, uint64_t>>("  SlruCache", capacity, trace);
+        // Both are exact LRU, so they must hit on exactly the same accesses.
+        sameHits = sameHits && lru.hits == reference.hits;
+        slabAllocations += lru.allocations + slru.allocations;
+        cout << endl;
+        if (w.exponent == 0.99 && !w.scans)
+            zipf99.swap(trace);
+    }
+
+    benchSection(to_string(threads) + " threads", "zipf 0.99");
+    {
+        LruCache<uint64_t, uint64_t> cache(capacity);
+        mutex lock;
+        threaded("  one mutex + LruCache", zipf99, threads, [&](uint64_t key)
+                 {
+            lock_guard<mutex> guard(lock);
+            if (cache.get(key) != nullptr)
+                return 1;
+            cache.put(key, key);
+            return 0; });
+    }
+    {
+        ShardedCache<LruCache<uint64_t, uint64_t>> cache(capacity);
+        threaded("  ShardedCache<LruCache>", zipf99, threads, [&](uint64_t key)
+                 {
+            uint64_t value;
+            if (cache.get(key, value))
+                return 1;
+            cache.put(key, key);
+            return 0; });
+    }
+    {
+        ShardedCache<SlruCache<uint64_t, uint64_t>> cache(capacity);
+        threaded("  ShardedCache<SlruCache>", zipf99, threads, [&](uint64_t key)
+                 {
+            uint64_t value;
+            if (cache.get(key, value))
+                return 1;
+            cache.put(key, key);
+            return 0; });
+    }
+
+    // ShardedCache hashes each key once to pick the shard; the shard's table
+    // must hash it again with the same hasher.
+    cout << "allocations while replaying LruCache / SlruCache: " << slabAllocations << endl;
+    cout << "LruCache hits match std::list + unordered_map: " << (sameHits ? "yes" : "no") << endl;
+    bool ok = slabAllocations == 0 && sameHits;
+    const size_t puts = 1000;
+    {
+        size_t calls = 0;
+        ShardedCache<LruCache<uint64_t, uint64_t, CountingHash>> cache(2 * puts, 4, CountingHash{&calls});
+        for (uint64_t key = 0; key < puts; ++key)
+            cache.put(key, key);
+        ok = ok && calls >= 2 * puts;
+    }
+    {
+        typedef SlruCache<uint64_t, uint64_t, CountingHash> Slru;
+        size_t calls = 0;
+        ShardedCache<Slru> cache(2 * puts, 4, CountingHash{&calls}, [](size_t shardCapacity, const CountingHash &hash)
+                                 { return unique_ptr<Slru>(new Slru(shardCapacity, 0.5, hash)); });
+        for (uint64_t key = 0; key < puts; ++key)
+            cache.put(key, key);
+        ok = ok && calls >= 2 * puts;
+    }
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
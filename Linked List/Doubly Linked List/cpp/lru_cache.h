@@ -0,0 +1,476 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../../../Hashing/cpp/flat_hash_map.h"
+
+// Fixed-capacity caches whose recency lists are intrusive.
+//
+// The usual LRU is a std::list of entries plus a std::unordered_map from
+// key to list iterator: two allocations and two pointer-chasing structures
+// per entry. Here every entry (key, value and its prev / next links, as
+// 32-bit indices) sits in one slab allocated up front, and a FlatHashMap
+// maps each key to its slab index. A hit is one probe plus a few index
+// writes, and a miss reuses the evicted entry in place: nothing is allocated
+// after construction. The index is reserved for twice the capacity, so at
+// under 45% load an erase rarely leaves a tombstone; if the tombstones ever
+// fill it anyway, FlatHashMap rebuilds it in place instead of growing.
+//
+//   LruCache   one recency list; evicts the least recently used entry
+//   SlruCache  segmented LRU: new entries go to a probation segment and
+//              are promoted to a protected segment (80% of the capacity)
+//              on their second hit. A scan of one-off keys only churns
+//              probation, so the protected working set survives it.
+//
+// get() returns a pointer to the cached value, valid until the next put()
+// or erase(). Neither cache is synchronized; ShardedCache wraps either one
+// for concurrent use. K and V must be default constructible.
+namespace lru_detail
+{
+    const std::uint32_t kNil = 0xFFFFFFFFu;
+
+    template <typename K, typename V>
+    struct Entry
+    {
+        K key;
+        V value;
+        std::uint32_t prev = kNil;
+        std::uint32_t next = kNil;
+        std::uint8_t segment = 0;
+    };
+
+    // A recency list threaded through the slab: head is the most recently
+    // used entry, tail the eviction candidate.
+    struct List
+    {
+        std::uint32_t head = kNil;
+        std::uint32_t tail = kNil;
+        std::uint32_t size = 0;
+    };
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    class LinkedSlab
+    {
+    protected:
+        std::vector<Entry<K, V>> slab;
+        std::uint32_t used = 0;
+        std::uint32_t freeList = kNil; // through Entry::next
+        FlatHashMap<K, std::uint32_t, Hash, KeyEqual> index;
+
+        explicit LinkedSlab(std::size_t capacity, const Hash &hash, const KeyEqual &keyEqual)
+            : index(2 * capacity, hash, keyEqual)
+        {
+            if (capacity == 0 || capacity >= kNil)
+            {
+                throw std::invalid_argument("cache capacity must be in 1..2^32-2");
+            }
+            slab.resize(capacity);
+        }
+
+        void pushFront(List &list, std::uint32_t i)
+        {
+            Entry<K, V> &entry = slab[i];
+            entry.prev = kNil;
+            entry.next = list.head;
+            (list.head != kNil ? slab[list.head].prev : list.tail) = i;
+            list.head = i;
+            ++list.size;
+        }
+
+        void unlink(List &list, std::uint32_t i)
+        {
+            Entry<K, V> &entry = slab[i];
+            (entry.prev != kNil ? slab[entry.prev].next : list.head) = entry.next;
+            (entry.next != kNil ? slab[entry.next].prev : list.tail) = entry.prev;
+            --list.size;
+        }
+
+        void moveToFront(List &list, std::uint32_t i)
+        {
+            if (list.head != i)
+            {
+                unlink(list, i);
+                pushFront(list, i);
+            }
+        }
+
+        // A free slab entry, or kNil when the slab is full.
+        std::uint32_t takeFree()
+        {
+            if (freeList != kNil)
+            {
+                std::uint32_t i = freeList;
+                freeList = slab[i].next;
+                return i;
+            }
+            return used < slab.size() ? used++ : kNil;
+        }
+
+        // Drops entry i from the index and returns it to the free list; the
+        // caller unlinks it first.
+        void release(std::uint32_t i)
+        {
+            index.erase(slab[i].key);
+            slab[i].key = K();
+            slab[i].value = V();
+            slab[i].next = freeList;
+            freeList = i;
+        }
+
+        // Unlinks the tail of `from` and rebinds that entry to key, without
+        // touching the free list.
+        std::uint32_t recycleTail(List &from, const K &key)
+        {
+            std::uint32_t i = from.tail;
+            unlink(from, i);
+            index.erase(slab[i].key);
+            slab[i].key = key;
+            return i;
+        }
+
+        std::uint32_t lookup(const K &key) const
+        {
+            const std::uint32_t *i = index.find(key);
+            return i != nullptr ? *i : kNil;
+        }
+
+    public:
+        std::size_t size() const { return index.size(); }
+        std::size_t capacity() const { return slab.size(); }
+        bool contains(const K &key) const { return index.contains(key); }
+
+        // Value of key without counting it as a use, or nullptr.
+        const V *peek(const K &key) const
+        {
+            std::uint32_t i = lookup(key);
+            return i != kNil ? &slab[i].value : nullptr;
+        }
+    };
+} // namespace lru_detail
+
+template <typename K, typename V, typename Hash = DefaultHash<K>, typename KeyEqual = DefaultEqual<K>>
+class LruCache : public lru_detail::LinkedSlab<K, V, Hash, KeyEqual>
+{
+private:
+    typedef lru_detail::LinkedSlab<K, V, Hash, KeyEqual> Base;
+    using Base::slab;
+    lru_detail::List recency;
+
+public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef Hash hasher;
+
+    explicit LruCache(std::size_t capacity, const Hash &hash = Hash(), const KeyEqual &keyEqual = KeyEqual())
+        : Base(capacity, hash, keyEqual) {}
+
+    // Value of key, marked most recently used; nullptr on a miss.
+    V *get(const K &key)
+    {
+        std::uint32_t i = this->lookup(key);
+        if (i == lru_detail::kNil)
+        {
+            return nullptr;
+        }
+        this->moveToFront(recency, i);
+        return &slab[i].value;
+    }
+
+    // Inserts or overwrites key, marking it most recently used; evicts the
+    // least recently used entry when full. Returns true if key was new.
+    template <typename VArg>
+    bool put(const K &key, VArg &&value)
+    {
+        std::uint32_t i = this->lookup(key);
+        if (i != lru_detail::kNil)
+        {
+            slab[i].value = std::forward<VArg>(value);
+            this->moveToFront(recency, i);
+            return false;
+        }
+        i = this->takeFree();
+        if (i == lru_detail::kNil)
+        {
+            i = this->recycleTail(recency, key);
+        }
+        else
+        {
+            slab[i].key = key;
+        }
+        slab[i].value = std::forward<VArg>(value);
+        this->index.insert(key, i);
+        this->pushFront(recency, i);
+        return true;
+    }
+
+    bool erase(const K &key)
+    {
+        std::uint32_t i = this->lookup(key);
+        if (i == lru_detail::kNil)
+        {
+            return false;
+        }
+        this->unlink(recency, i);
+        this->release(i);
+        return true;
+    }
+
+    // Calls visit(key, value) from most to least recently used.
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (std::uint32_t i = recency.head; i != lru_detail::kNil; i = slab[i].next)
+        {
+            visit(slab[i].key, slab[i].value);
+        }
+    }
+};
+
+template <typename K, typename V, typename Hash = DefaultHash<K>, typename KeyEqual = DefaultEqual<K>>
+class SlruCache : public lru_detail::LinkedSlab<K, V, Hash, KeyEqual>
+{
+private:
+    typedef lru_detail::LinkedSlab<K, V, Hash, KeyEqual> Base;
+    using Base::slab;
+    enum
+    {
+        kProbation = 0,
+        kProtected = 1
+    };
+    lru_detail::List segments[2];
+    std::size_t protectedLimit;
+
+    // Counts a use of entry i: probation entries are promoted, and the
+    // protected segment's overflow is demoted back to probation.
+    void touch(std::uint32_t i)
+    {
+        if (slab[i].segment == kProtected)
+        {
+            this->moveToFront(segments[kProtected], i);
+            return;
+        }
+        this->unlink(segments[kProbation], i);
+        slab[i].segment = kProtected;
+        this->pushFront(segments[kProtected], i);
+        if (segments[kProtected].size > protectedLimit)
+        {
+            std::uint32_t demoted = segments[kProtected].tail;
+            this->unlink(segments[kProtected], demoted);
+            slab[demoted].segment = kProbation;
+            this->pushFront(segments[kProbation], demoted);
+        }
+    }
+
+public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef Hash hasher;
+
+    // protectedFraction of the capacity is kept for entries hit at least
+    // twice.
+    explicit SlruCache(std::size_t capacity, double protectedFraction = 0.8, const Hash &hash = Hash(),
+                       const KeyEqual &keyEqual = KeyEqual())
+        : Base(capacity, hash, keyEqual),
+          protectedLimit(std::min(capacity - 1, (std::size_t)(capacity * protectedFraction)))
+    {
+    }
+
+    V *get(const K &key)
+    {
+        std::uint32_t i = this->lookup(key);
+        if (i == lru_detail::kNil)
+        {
+            return nullptr;
+        }
+        touch(i);
+        return &slab[i].value;
+    }
+
+    // Inserts or overwrites key. A new key enters probation, evicting the
+    // least recently used probation entry when full; an existing key counts
+    // as a use. Returns true if key was new.
+    template <typename VArg>
+    bool put(const K &key, VArg &&value)
+    {
+        std::uint32_t i = this->lookup(key);
+        if (i != lru_detail::kNil)
+        {
+            slab[i].value = std::forward<VArg>(value);
+            touch(i);
+            return false;
+        }
+        i = this->takeFree();
+        if (i == lru_detail::kNil)
+        {
+            lru_detail::List &victims = segments[kProbation].size > 0 ? segments[kProbation] : segments[kProtected];
+            i = this->recycleTail(victims, key);
+        }
+        else
+        {
+            slab[i].key = key;
+        }
+        slab[i].value = std::forward<VArg>(value);
+        slab[i].segment = kProbation;
+        this->index.insert(key, i);
+        this->pushFront(segments[kProbation], i);
+        return true;
+    }
+
+    bool erase(const K &key)
+    {
+        std::uint32_t i = this->lookup(key);
+        if (i == lru_detail::kNil)
+        {
+            return false;
+        }
+        this->unlink(segments[slab[i].segment], i);
+        this->release(i);
+        return true;
+    }
+
+    std::size_t protectedSize() const { return segments[kProtected].size; }
+};
+
+namespace lru_detail
+{
+    // A ShardedCache shard with the cache's default settings, hashing with
+    // the ShardedCache's hasher.
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    std::unique_ptr<LruCache<K, V, Hash, KeyEqual>> makeShard(const LruCache<K, V, Hash, KeyEqual> *,
+                                                              std::size_t capacity, const Hash &hash)
+    {
+        return std::unique_ptr<LruCache<K, V, Hash, KeyEqual>>(new LruCache<K, V, Hash, KeyEqual>(capacity, hash));
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    std::unique_ptr<SlruCache<K, V, Hash, KeyEqual>> makeShard(const SlruCache<K, V, Hash, KeyEqual> *,
+                                                               std::size_t capacity, const Hash &hash)
+    {
+        return std::unique_ptr<SlruCache<K, V, Hash, KeyEqual>>(
+            new SlruCache<K, V, Hash, KeyEqual>(capacity, 0.8, hash));
+    }
+} // namespace lru_detail
+
+// Thread-safe cache made of independently locked shards of Cache (LruCache
+// or SlruCache), each with capacity / shardCount entries, chosen by high
+// bits of the key's hash as in ConcurrentHashMap. A cache hit reorders the
+// recency list, so every operation takes its shard's lock exclusively;
+// sharding is what lets threads proceed in parallel. Recency is per shard,
+// so eviction is LRU within a shard, not across the whole cache.
+template <typename Cache>
+class ShardedCache
+{
+public:
+    typedef typename Cache::key_type K;
+    typedef typename Cache::mapped_type V;
+    typedef typename Cache::hasher Hash;
+
+private:
+    struct alignas(64) Shard
+    {
+        std::mutex lock;
+        std::unique_ptr<Cache> cache;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    std::size_t shardMask;
+    Hash hasher;
+
+    Shard &shardOf(const K &key) const
+    {
+        std::uint64_t h = (std::uint64_t)hasher(key);
+        if (!HashIsAvalanching<Hash>::value)
+        {
+            h = hash_detail::mix(h, 0x9E3779B97F4A7C15ull);
+        }
+        return shards[(std::size_t)(h >> 40) & shardMask];
+    }
+
+public:
+    // shardCount is rounded up to a power of two; 0 picks 4 per hardware
+    // thread (but no more than leave each shard 64 entries). Every shard
+    // hashes with a copy of hash.
+    explicit ShardedCache(std::size_t capacity, std::size_t shardCount = 0, const Hash &hash = Hash())
+        : ShardedCache(capacity, shardCount, hash, [](std::size_t shardCapacity, const Hash &shardHash)
+                       { return lru_detail::makeShard(static_cast<const Cache *>(nullptr), shardCapacity, shardHash); })
+    {
+    }
+
+    // Builds each shard with makeShard(shardCapacity, hash), which returns a
+    // std::unique_ptr<Cache> and should hand hash to the cache; e.g. for
+    // SlruCache shards with another protected fraction.
+    template <typename MakeShard>
+    ShardedCache(std::size_t capacity, std::size_t shardCount, const Hash &hash, MakeShard makeShard)
+        : hasher(hash)
+    {
+        if (shardCount == 0)
+        {
+            shardCount = std::min<std::size_t>(4 * std::max(1u, std::thread::hardware_concurrency()),
+                                               std::max<std::size_t>(1, capacity / 64));
+        }
+        std::size_t count = 1;
+        while (count < shardCount && count < ((std::size_t)1 << 16))
+        {
+            count *= 2;
+        }
+        shards.reset(new Shard[count]);
+        shardMask = count - 1;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            shards[i].cache = makeShard(std::max<std::size_t>(1, (capacity + i) / count), hasher);
+        }
+    }
+
+    std::size_t shardCount() const { return shardMask + 1; }
+
+    // Copies the value of key into value, marking it used. Returns false on
+    // a miss.
+    bool get(const K &key, V &value)
+    {
+        Shard &shard = shardOf(key);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        const V *found = shard.cache->get(key);
+        if (found == nullptr)
+        {
+            return false;
+        }
+        value = *found;
+        return true;
+    }
+
+    template <typename VArg>
+    bool put(const K &key, VArg &&value)
+    {
+        Shard &shard = shardOf(key);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        return shard.cache->put(key, std::forward<VArg>(value));
+    }
+
+    bool erase(const K &key)
+    {
+        Shard &shard = shardOf(key);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        return shard.cache->erase(key);
+    }
+
+    std::size_t size() const
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i <= shardMask; ++i)
+        {
+            std::lock_guard<std::mutex> guard(shards[i].lock);
+            total += shards[i].cache->size();
+        }
+        return total;
+    }
+};
+
+#endif // LRU_CACHE_H
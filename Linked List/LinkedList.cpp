@@ -1,31 +1,25 @@
 #include <iostream>
 #include <vector>
+#include "node_pool.h"
+#include "list_set_ops.h"
+#include "list_node.h"
 
 using namespace std;
 
-struct Node
+// Functions that create or free nodes take an allocator handle from
+// node_pool.h; the default is plain new / delete.
+template <typename Alloc = HeapAllocator<Node>>
+void insertAtBeginning(Node *&head, int data, Alloc alloc = Alloc())
 {
-    /* data */
-    int data;
-    Node *next;
-
-    Node(int data)
-    {
-        this->data = data;
-        this->next = nullptr;
-    }
-};
-
-void insertAtBeginning(Node *&head, int data)
-{
-    Node *newNode = new Node(data);
+    Node *newNode = alloc.create(data);
     newNode->next = head;
     head = newNode;
 }
 
-void inserAtEnd(Node *&head, int data)
+template <typename Alloc = HeapAllocator<Node>>
+void inserAtEnd(Node *&head, int data, Alloc alloc = Alloc())
 {
-    Node *newNode = new Node(data);
+    Node *newNode = alloc.create(data);
     if (head == nullptr)
     {
         head = newNode;
@@ -41,7 +35,8 @@ void inserAtEnd(Node *&head, int data)
     temp->next = newNode;
 }
 
-void insertAfter(Node *prevNode, int data)
+template <typename Alloc = HeapAllocator<Node>>
+void insertAfter(Node *prevNode, int data, Alloc alloc = Alloc())
 {
 
     if (prevNode == nullptr)
@@ -49,13 +44,14 @@ void insertAfter(Node *prevNode, int data)
         cout << "the pervious ndoe can not be null.";
         return;
     }
-    Node *newNode = new Node(data);
+    Node *newNode = alloc.create(data);
 
     newNode->next = prevNode->next;
     prevNode->next = newNode;
 }
 
-void deleteAtBeginning(Node *&head)
+template <typename Alloc = HeapAllocator<Node>>
+void deleteAtBeginning(Node *&head, Alloc alloc = Alloc())
 {
     if (head == nullptr)
     {
@@ -63,9 +59,10 @@ void deleteAtBeginning(Node *&head)
     }
     Node *temp = head;
     head = head->next;
-    delete temp;
+    alloc.destroy(temp);
 }
-void deleteAtEnd(Node *&head)
+template <typename Alloc = HeapAllocator<Node>>
+void deleteAtEnd(Node *&head, Alloc alloc = Alloc())
 {
     if (head == nullptr)
     {
@@ -73,7 +70,7 @@ void deleteAtEnd(Node *&head)
     }
     if (head->next == nullptr)
     {
-        delete head;
+        alloc.destroy(head);
         head = nullptr;
         return;
     }
@@ -83,7 +80,7 @@ void deleteAtEnd(Node *&head)
         temp = temp->next;
     }
 
-    delete temp->next;
+    alloc.destroy(temp->next);
     temp->next = nullptr;
 }
 
@@ -152,25 +149,48 @@ bool detectLoop(Node *head)
     return false;
 }
 
-void removeDuplicates(Node *head)
+// Keeps the first occurrence of every value, in one pass (see
+// list_set_ops.h for this and the sorted merge / intersection / difference).
+template <typename Alloc = HeapAllocator<Node>>
+void removeDuplicates(Node *head, Alloc alloc = Alloc())
 {
-    Node *current = head;
-    while (current != nullptr && current->next != nullptr)
+    removeDuplicatesHashed(head, alloc);
+}
+
+int main()
+{
+    Node *head = nullptr;
+    for (int value : {3, 1, 3, 2, 1, 4, 2})
     {
-        Node *temp = current;
-        while (temp->next != nullptr)
-        {
-            if (current->data == temp->next->data)
-            {
-                Node *duplicateNode = temp->next;
-                temp->next = temp->next->next;
-                delete duplicateNode;
-            }
-            else
-            {
-                temp = temp->next;
-            }
-        }
-        current = current->next;
+        inserAtEnd(head, value);
+    }
+    cout << "List: ";
+    traverse(head);
+
+    removeDuplicates(head);
+    cout << "After removeDuplicates: ";
+    traverse(head);
+    cout << "Length: " << lenght(head) << ", 4 present: " << (search(head, 4) ? "yes" : "no") << endl;
+
+    // The same, drawing nodes from this thread's NodePool.
+    PoolAllocator<Node> pool;
+    Node *pooled = nullptr;
+    for (int value : {5, 5, 6, 5, 7})
+    {
+        inserAtEnd(pooled, value, pool);
     }
-}
\ No newline at end of file
+    removeDuplicates(pooled, pool);
+    cout << "Pooled after removeDuplicates: ";
+    traverse(pooled);
+    cout << "Pool nodes in use: " << pool.pool->liveCount() << endl;
+
+    while (head != nullptr)
+    {
+        deleteAtBeginning(head);
+    }
+    while (pooled != nullptr)
+    {
+        deleteAtBeginning(pooled, pool);
+    }
+    return 0;
+}
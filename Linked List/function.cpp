@@ -1,26 +1,27 @@
 #include <iostream>
+#include "node_pool.h"
+#include "singly_linked_list.h"
+#include "list_sort.h"
+#include "list_node.h"
 using namespace std;
 
-struct Node
-{
-    int data;
-    Node *next;
-
-    Node(int val) : data(val), next(nullptr) {}
-};
+// Functions that create or free nodes take an allocator handle from
+// node_pool.h; the default is plain new / delete.
 
 // Function to insert at the beginning
-void insertAtBeginning(Node *&head, int val)
+template <typename Alloc = HeapAllocator<Node>>
+void insertAtBeginning(Node *&head, int val, Alloc alloc = Alloc())
 {
-    Node *newNode = new Node(val);
+    Node *newNode = alloc.create(val);
     newNode->next = head;
     head = newNode;
 }
 
 // Function to insert at the end
-void insertAtEnd(Node *&head, int val)
+template <typename Alloc = HeapAllocator<Node>>
+void insertAtEnd(Node *&head, int val, Alloc alloc = Alloc())
 {
-    Node *newNode = new Node(val);
+    Node *newNode = alloc.create(val);
     if (head == nullptr)
     {
         head = newNode;
@@ -35,20 +36,22 @@ void insertAtEnd(Node *&head, int val)
 }
 
 // Function to insert after a specific node
-void insertAfter(Node *prevNode, int val)
+template <typename Alloc = HeapAllocator<Node>>
+void insertAfter(Node *prevNode, int val, Alloc alloc = Alloc())
 {
     if (prevNode == nullptr)
     {
         cout << "Previous node cannot be NULL\n";
         return;
     }
-    Node *newNode = new Node(val);
+    Node *newNode = alloc.create(val);
     newNode->next = prevNode->next;
     prevNode->next = newNode;
 }
 
 // Function to delete a node by value
-void deleteByValue(Node *&head, int val)
+template <typename Alloc = HeapAllocator<Node>>
+void deleteByValue(Node *&head, int val, Alloc alloc = Alloc())
 {
     if (head == nullptr)
     {
@@ -60,7 +63,7 @@ void deleteByValue(Node *&head, int val)
     {
         Node *temp = head;
         head = head->next;
-        delete temp;
+        alloc.destroy(temp);
         return;
     }
 
@@ -78,11 +81,12 @@ void deleteByValue(Node *&head, int val)
 
     Node *delNode = temp->next;
     temp->next = temp->next->next;
-    delete delNode;
+    alloc.destroy(delNode);
 }
 
 // Function to delete a node by position
-void deleteByPosition(Node *&head, int position)
+template <typename Alloc = HeapAllocator<Node>>
+void deleteByPosition(Node *&head, int position, Alloc alloc = Alloc())
 {
     if (head == nullptr)
     {
@@ -94,7 +98,7 @@ void deleteByPosition(Node *&head, int position)
     {
         Node *temp = head;
         head = head->next;
-        delete temp;
+        alloc.destroy(temp);
         return;
     }
 
@@ -115,7 +119,7 @@ void deleteByPosition(Node *&head, int position)
 
     Node *delNode = temp->next;
     temp->next = temp->next->next;
-    delete delNode;
+    alloc.destroy(delNode);
 }
 
 // Function to display the linked list
@@ -203,14 +207,15 @@ bool detectCycle(Node *head)
 }
 
 // Function to delete the entire list
-void deleteList(Node *&head)
+template <typename Alloc = HeapAllocator<Node>>
+void deleteList(Node *&head, Alloc alloc = Alloc())
 {
     Node *temp = head;
     while (head)
     {
         temp = head;
         head = head->next;
-        delete temp;
+        alloc.destroy(temp);
     }
 }
 
@@ -251,8 +256,46 @@ int main()
 
     cout << "Cycle detection: " << (detectCycle(head) ? "Cycle found" : "No cycle") << endl;
 
+    // Sorting relinks the nodes in place (list_sort.h).
+    insertAtEnd(head, 15);
+    insertAtEnd(head, -3);
+    mergeSortList(head);
+    cout << "Merge sorted: ";
+    display(head);
+    reverse(head);
+    radixSortList(head);
+    cout << "Radix sorted: ";
+    display(head);
+
     // Clean up the list
     deleteList(head);
 
+    // The same functions drawing nodes from this thread's NodePool.
+    PoolAllocator<Node> pool;
+    Node *pooled = nullptr;
+    for (int i = 1; i <= 5; i++)
+    {
+        insertAtEnd(pooled, i * 100, pool);
+    }
+    deleteByValue(pooled, 300, pool);
+    cout << "Pooled list: ";
+    display(pooled);
+    cout << "Pool nodes in use: " << pool.pool->liveCount() << endl;
+    deleteList(pooled, pool);
+
+    // SinglyLinkedList keeps tail and size: appending and counting are O(1).
+    SinglyLinkedList<int> list = {1, 2, 3};
+    int more[] = {4, 5, 6};
+    list.append(more, more + 3);
+    SinglyLinkedList<int> tail = {7, 8};
+    list.splice(tail);
+    list.insertAfter(list.find(3), 35);
+    cout << "SinglyLinkedList (" << list.size() << " nodes): ";
+    for (int value : list)
+    {
+        cout << value << " -> ";
+    }
+    cout << "nullptr\n";
+
     return 0;
 }
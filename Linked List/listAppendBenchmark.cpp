@@ -0,0 +1,136 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include "singly_linked_list.h"
+#include "list_node.h"
+#include "../bench/bench_util.h"
+
+using namespace std;
+
+// Building a list by appending, head-only versus SinglyLinkedList:
+//   insertAtEnd   the free function from function.cpp, walks to the end
+//                 every call, so building n nodes is O(n^2)
+//   pushBack      O(1) through the tail pointer
+//   append        bulk append of a vector range
+//   splice        concatenating two lists of n / 2 nodes
+// insertAtEnd runs on doubling sizes up to `quadraticLimit` (per-node cost
+// grows with n); its time for n nodes is extrapolated from the largest run.
+// Then length via countNodes versus size().
+//
+// Usage: ./listAppendBenchmark [nodes] [quadraticLimit]   (default 10000000 32000)
+
+// insertAtEnd as function.cpp defines it (without the allocator handle).
+void insertAtEnd(Node *&head, int val)
+{
+    Node *newNode = new Node(val);
+    if (head == nullptr)
+    {
+        head = newNode;
+        return;
+    }
+    Node *temp = head;
+    while (temp->next)
+    {
+        temp = temp->next;
+    }
+    temp->next = newNode;
+}
+
+int countNodes(Node *head)
+{
+    int count = 0;
+    for (Node *temp = head; temp; temp = temp->next)
+        count++;
+    return count;
+}
+
+void deleteList(Node *&head)
+{
+    while (head)
+    {
+        Node *temp = head;
+        head = head->next;
+        delete temp;
+    }
+}
+
+void report(const string &label, size_t n, double seconds)
+{
+    report(label, {{(double)n, "nodes", 0}, {seconds * 1e3, "ms", 3}, {seconds * 1e9 / n, "ns/node"}}, 32);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    size_t quadraticLimit = argc > 2 ? strtoull(argv[2], nullptr, 10) : 32000;
+    bool ok = true;
+
+    double perNodeSquared = 0;
+    for (size_t m = 4000; m <= quadraticLimit && m <= n; m *= 2)
+    {
+        Node *head = nullptr;
+        double seconds = timeIt([&]()
+                                {
+            for (size_t i = 0; i < m; i++)
+                insertAtEnd(head, (int)i); });
+        report("insertAtEnd " + to_string(m), m, seconds);
+        perNodeSquared = seconds / ((double)m * m);
+        ok = ok && countNodes(head) == (int)m;
+        deleteList(head);
+    }
+    if (perNodeSquared > 0)
+    {
+        double estimate = perNodeSquared * (double)n * n;
+        report("insertAtEnd (extrapolated)", {{(double)n, "nodes", 0}, {estimate, "s", 1}}, 32);
+    }
+    cout << endl;
+
+    for (size_t m = n / 8; m <= n && m > 0; m *= 2)
+    {
+        SinglyLinkedList<int> list;
+        double seconds = timeIt([&]()
+                                {
+            for (size_t i = 0; i < m; i++)
+                list.pushBack((int)i); });
+        report("SinglyLinkedList pushBack " + to_string(m), m, seconds);
+        ok = ok && list.size() == m && list.back() == (int)(m - 1);
+    }
+
+    vector<int> values(n);
+    for (size_t i = 0; i < n; i++)
+        values[i] = (int)i;
+    {
+        SinglyLinkedList<int> list;
+        double seconds = timeIt([&]()
+                                { list.append(values.begin(), values.end()); });
+        report("SinglyLinkedList append", n, seconds);
+        ok = ok && list.size() == n;
+    }
+    {
+        SinglyLinkedList<int> first(values.begin(), values.begin() + n / 2);
+        SinglyLinkedList<int> second(values.begin() + n / 2, values.end());
+        double seconds = timeIt([&]()
+                                { first.splice(second); });
+        report("SinglyLinkedList splice", {{(double)n, "nodes", 0}, {seconds * 1e6, "us", 3}}, 32);
+        ok = ok && first.size() == n && second.empty() && first.back() == (int)(n - 1);
+
+        size_t length = 0;
+        double walk = timeIt([&]()
+                             {
+            for (int value : first)
+            {
+                (void)value;
+                length++;
+            } });
+        report("length by walking", n, walk);
+        volatile size_t cached = 0;
+        double sized = timeIt([&]()
+                              { cached = first.size(); });
+        report("length by size()", {{(double)n, "nodes", 0}, {sized * 1e6, "us", 3}}, 32);
+        ok = ok && length == n && cached == n;
+    }
+
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+#include "list_set_ops.h"
+#include "list_node.h"
+#include "../bench/bench_util.h"
+
+using namespace std;
+
+// Dedup and sorted set operations on head-pointer lists, for two inputs:
+//   duplicate-heavy   values drawn from 1000 distinct keys
+//   unique-heavy      random 32-bit values (almost all distinct)
+// removeDuplicates is timed as the old nested scan (on at most
+// `quadraticLimit` nodes, it is O(n * distinct)) and as the hashed single
+// pass on the full list. mergeSorted / intersectSorted / differenceSorted
+// run on two sorted lists of n nodes each. Results are checked against the
+// <algorithm> equivalents on vectors.
+//
+// Usage: ./listSetOpsBenchmark [nodes] [quadraticLimit]   (default 1000000 20000)
+
+// The nested scan removeDuplicates used before.
+void removeDuplicatesNested(Node *head)
+{
+    Node *current = head;
+    while (current != nullptr && current->next != nullptr)
+    {
+        Node *temp = current;
+        while (temp->next != nullptr)
+        {
+            if (current->data == temp->next->data)
+            {
+                Node *duplicateNode = temp->next;
+                temp->next = temp->next->next;
+                delete duplicateNode;
+            }
+            else
+            {
+                temp = temp->next;
+            }
+        }
+        current = current->next;
+    }
+}
+
+Node *build(const vector<int> &values)
+{
+    Node *head = nullptr;
+    Node **link = &head;
+    for (int value : values)
+    {
+        *link = new Node(value);
+        link = &(*link)->next;
+    }
+    return head;
+}
+
+vector<int> toVector(const Node *head)
+{
+    vector<int> values;
+    for (; head != nullptr; head = head->next)
+        values.push_back(head->data);
+    return values;
+}
+
+void deleteList(Node *head)
+{
+    while (head)
+    {
+        Node *temp = head;
+        head = head->next;
+        delete temp;
+    }
+}
+
+void report(const string &label, size_t n, double seconds)
+{
+    report(label, {{(double)n, "nodes", 0}, {seconds * 1e3, "ms"}, {seconds * 1e9 / n, "ns/node"}}, 36);
+}
+
+vector<int> firstOccurrences(const vector<int> &values)
+{
+    vector<int> kept;
+    FlatHashMap<int, char> seen;
+    for (int value : values)
+        if (seen.insert(value, 0))
+            kept.push_back(value);
+    return kept;
+}
+
+bool run(const string &title, size_t n, size_t quadraticLimit, uint32_t distinct)
+{
+    benchSection(title);
+    mt19937 rng(7);
+    auto draw = [&]()
+    { return distinct ? (int)(rng() % distinct) : (int)rng(); };
+    bool ok = true;
+
+    size_t small = min(n, quadraticLimit);
+    vector<int> values(n);
+    for (int &value : values)
+        value = draw();
+    vector<int> expectSmall = firstOccurrences(vector<int>(values.begin(), values.begin() + small));
+    vector<int> expect = firstOccurrences(values);
+
+    Node *head = build(vector<int>(values.begin(), values.begin() + small));
+    report("  removeDuplicates nested scan", small, timeIt([&]()
+                                                           { removeDuplicatesNested(head); }));
+    ok = ok && toVector(head) == expectSmall;
+    deleteList(head);
+
+    head = build(vector<int>(values.begin(), values.begin() + small));
+    report("  removeDuplicates hashed (prefix)", small, timeIt([&]()
+                                                      { removeDuplicatesHashed(head); }));
+    ok = ok && toVector(head) == expectSmall;
+    deleteList(head);
+
+    head = build(values);
+    report("  removeDuplicates hashed", n, timeIt([&]()
+                                                  { removeDuplicatesHashed(head); }));
+    ok = ok && toVector(head) == expect;
+    deleteList(head);
+
+    vector<int> left(n), right(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        left[i] = draw();
+        right[i] = draw();
+    }
+    sort(left.begin(), left.end());
+    sort(right.begin(), right.end());
+    vector<int> merged, common, onlyLeft;
+    merge(left.begin(), left.end(), right.begin(), right.end(), back_inserter(merged));
+    set_intersection(left.begin(), left.end(), right.begin(), right.end(), back_inserter(common));
+    set_difference(left.begin(), left.end(), right.begin(), right.end(), back_inserter(onlyLeft));
+
+    Node *a = build(left), *b = build(right), *result = nullptr;
+    report("  intersectSorted", 2 * n, timeIt([&]()
+                                             { result = intersectSorted(a, b); }));
+    ok = ok && toVector(result) == common;
+    deleteList(result);
+    report("  differenceSorted", 2 * n, timeIt([&]()
+                                              { result = differenceSorted(a, b); }));
+    ok = ok && toVector(result) == onlyLeft;
+    deleteList(result);
+    report("  mergeSorted", 2 * n, timeIt([&]()
+                                         { result = mergeSorted(a, b); }));
+    ok = ok && toVector(result) == merged;
+    deleteList(result);
+
+    cout << "  checks: " << (ok ? "ok" : "FAILED") << endl
+         << endl;
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t quadraticLimit = argc > 2 ? strtoull(argv[2], nullptr, 10) : 20000;
+    bool ok = run("duplicate-heavy (1000 distinct values)", n, quadraticLimit, 1000);
+    ok = run("unique-heavy (random 32-bit values)", n, quadraticLimit, 0) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "list_sort.h"
+#include "list_node.h"
+#include "../bench/bench_util.h"
+
+using namespace std;
+
+// Sorting an n-node list of random ints three ways:
+//   copy + std::sort   copy the values to a vector, sort, build a new list
+//                      and free the old one (what callers did before)
+//   mergeSortList      bottom-up merge sort by relinking
+//   radixSortList      LSD radix sort by relinking, 16-bit digits (the
+//                      default) and 8-bit digits
+// Each variant runs in its own process; besides the time it reports the
+// resident set (RSS) with the unsorted list built and the peak RSS during
+// the sort (ru_maxrss), so the extra memory a sort needs is the difference.
+//
+// Usage: ./listSortBenchmark [n] [valueRange]   (default 10000000, full int range)
+
+Node *buildList(size_t n, long long valueRange)
+{
+    mt19937_64 rng(11);
+    Node *head = nullptr;
+    Node **link = &head;
+    for (size_t i = 0; i < n; i++)
+    {
+        int value = valueRange > 0 ? (int)(rng() % valueRange) : (int)rng();
+        *link = new Node(value);
+        link = &(*link)->next;
+    }
+    return head;
+}
+
+void deleteList(Node *&head)
+{
+    while (head)
+    {
+        Node *temp = head;
+        head = head->next;
+        delete temp;
+    }
+}
+
+void sortByCopy(Node *&head)
+{
+    vector<int> values;
+    for (Node *temp = head; temp; temp = temp->next)
+        values.push_back(temp->data);
+    sort(values.begin(), values.end());
+    Node *sorted = nullptr;
+    Node **link = &sorted;
+    for (int value : values)
+    {
+        *link = new Node(value);
+        link = &(*link)->next;
+    }
+    deleteList(head);
+    head = sorted;
+}
+
+// Runs one sort in a child process and prints its line.
+template <typename Sort>
+void run(const string &label, size_t n, long long valueRange, Sort sortList)
+{
+    cout.flush();
+    pid_t child = fork();
+    if (child == 0)
+    {
+        Node *head = buildList(n, valueRange);
+        double before = residentMiB();
+        double seconds = timeIt([&]()
+                                { sortList(head); });
+        double peak = peakMiB();
+
+        size_t count = 0;
+        bool sorted = true;
+        for (Node *temp = head; temp; temp = temp->next, count++)
+            if (temp->next && temp->next->data < temp->data)
+                sorted = false;
+        report(label, {{seconds * 1e3, "ms", 1}, {seconds * 1e9 / n, "ns/node", 1}, {before, "MiB list RSS", 1}, {peak, "MiB peak RSS", 1}}, 20);
+        if (!sorted || count != n)
+            cout << "  checks: FAILED" << endl;
+        cout.flush();
+        _exit(sorted && count == n ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    long long valueRange = argc > 2 ? atoll(argv[2]) : 0;
+    cout << n << " nodes" << endl;
+    run("copy + std::sort", n, valueRange, sortByCopy);
+    run("mergeSortList", n, valueRange, mergeSortList<Node>);
+    run("radixSortList", n, valueRange, radixSortList<Node>);
+    run("radixSortList 8 bit", n, valueRange, radixSortList<Node, 8>);
+    cout << "checks: ok" << endl;
+    return 0;
+}
@@ -0,0 +1,16 @@
+#ifndef LIST_NODE_H
+#define LIST_NODE_H
+
+// Node of the head-pointer singly linked lists: LinkedList.cpp and
+// function.cpp build their lists from it, and the list benchmarks measure
+// it. The helpers in list_set_ops.h / list_sort.h work on any node type with
+// `data` and `next` members, this one included.
+struct Node
+{
+    int data;
+    Node *next;
+
+    Node(int val) : data(val), next(nullptr) {}
+};
+
+#endif // LIST_NODE_H
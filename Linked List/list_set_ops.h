@@ -0,0 +1,136 @@
+#ifndef LIST_SET_OPS_H
+#define LIST_SET_OPS_H
+
+#include "node_pool.h"
+#include "../Hashing/cpp/flat_hash_map.h"
+
+// Whole-list operations on head-pointer lists, each in one pass.
+//
+// They work on any node type with `data` and `next` members (the Node of
+// LinkedList.cpp / function.cpp) and free or create nodes through the same
+// allocator handles as the insert / delete functions (node_pool.h).
+//
+//   removeDuplicatesHashed  keep the first occurrence of every value; one
+//                           pass with a hash set (the FlatHashMap behind
+//                           CustomHashTable) instead of a nested scan
+//   mergeSorted             merge two ascending lists by relinking
+//   intersectSorted         values in both ascending lists, as a new list
+//   differenceSorted        values of a not in b, as a new list
+//
+// The sorted operations follow std::set_intersection / set_difference on
+// lists with repeats: a value k times in a and m times in b appears
+// min(k, m) times in the intersection and max(k - m, 0) times in the
+// difference.
+
+// Unlinks and frees every node whose value appeared earlier in the list.
+// Returns the number of nodes removed. O(n) expected time, O(distinct)
+// extra memory.
+template <typename NodeT, typename Alloc = HeapAllocator<NodeT>>
+std::size_t removeDuplicatesHashed(NodeT *head, Alloc alloc = Alloc())
+{
+    typedef typename std::decay<decltype(head->data)>::type Value;
+    FlatHashMap<Value, char> seen;
+    std::size_t removed = 0;
+    NodeT *prev = nullptr;
+    NodeT *current = head;
+    while (current != nullptr)
+    {
+        if (seen.insert(current->data, 0))
+        {
+            prev = current;
+            current = current->next;
+        }
+        else
+        {
+            prev->next = current->next;
+            alloc.destroy(current);
+            current = prev->next;
+            ++removed;
+        }
+    }
+    return removed;
+}
+
+// Merges ascending lists a and b into one ascending list and returns its
+// head. Stable (on ties a's node comes first); no node is allocated or
+// copied, and a and b no longer head valid lists of their own.
+template <typename NodeT>
+NodeT *mergeSorted(NodeT *a, NodeT *b)
+{
+    NodeT *head = nullptr;
+    NodeT **link = &head;
+    while (a != nullptr && b != nullptr)
+    {
+        if (b->data < a->data)
+        {
+            *link = b;
+            b = b->next;
+        }
+        else
+        {
+            *link = a;
+            a = a->next;
+        }
+        link = &(*link)->next;
+    }
+    *link = a != nullptr ? a : b;
+    return head;
+}
+
+// Ascending list of the values present in both ascending lists a and b.
+// The inputs are left as they are.
+template <typename NodeT, typename Alloc = HeapAllocator<NodeT>>
+NodeT *intersectSorted(const NodeT *a, const NodeT *b, Alloc alloc = Alloc())
+{
+    NodeT *head = nullptr;
+    NodeT **link = &head;
+    while (a != nullptr && b != nullptr)
+    {
+        if (a->data < b->data)
+        {
+            a = a->next;
+        }
+        else if (b->data < a->data)
+        {
+            b = b->next;
+        }
+        else
+        {
+            *link = alloc.create(a->data);
+            link = &(*link)->next;
+            a = a->next;
+            b = b->next;
+        }
+    }
+    return head;
+}
+
+// Ascending list of the values of ascending list a that are not in
+// ascending list b. The inputs are left as they are.
+template <typename NodeT, typename Alloc = HeapAllocator<NodeT>>
+NodeT *differenceSorted(const NodeT *a, const NodeT *b, Alloc alloc = Alloc())
+{
+    NodeT *head = nullptr;
+    NodeT **link = &head;
+    while (a != nullptr)
+    {
+        if (b == nullptr || a->data < b->data)
+        {
+            *link = alloc.create(a->data);
+            link = &(*link)->next;
+            a = a->next;
+        }
+        else if (b->data < a->data)
+        {
+            b = b->next;
+        }
+        else
+        {
+            a = a->next;
+            b = b->next;
+        }
+    }
+    return head;
+}
+
+#endif // LIST_SET_OPS_H
@@ -0,0 +1,125 @@
+#ifndef LIST_SORT_H
+#define LIST_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "list_set_ops.h"
+
+// Sorting head-pointer lists in place, by relinking nodes only: no node is
+// allocated, copied or moved, and the extra memory (run or bucket pointers)
+// does not grow with the list, so sorting never needs a second copy of it in
+// a vector.
+// Both sorts are stable and work on any node type with `data` and `next`
+// members.
+//
+//   mergeSortList  bottom-up merge sort, O(n log n) comparisons, any data
+//                  with operator<
+//   radixSortList  LSD radix sort for integral data, O(n) per digit
+
+// Bottom-up (non-recursive) merge sort. Nodes are taken off the list one at
+// a time and carried into bins[i], which holds a sorted run of 2^i nodes,
+// like a binary counter; equal runs merge as they meet. Each node is only
+// merged with runs built from its neighbours, so the working set stays small
+// until the final merges, and the bins replace the recursion stack.
+template <typename NodeT>
+void mergeSortList(NodeT *&head)
+{
+    NodeT *bins[64] = {};
+    int used = 0;
+    while (head != nullptr)
+    {
+        NodeT *run = head;
+        head = head->next;
+        run->next = nullptr;
+        int i = 0;
+        for (; i < used && bins[i] != nullptr; ++i)
+        {
+            run = mergeSorted(bins[i], run); // the older run first keeps it stable
+            bins[i] = nullptr;
+        }
+        bins[i] = run;
+        if (i == used)
+        {
+            ++used;
+        }
+    }
+    for (int i = 0; i < used; ++i)
+    {
+        if (bins[i] != nullptr)
+        {
+            head = mergeSorted(bins[i], head);
+        }
+    }
+}
+
+// LSD radix sort for integral data (signed values sort correctly). Each
+// pass deals the nodes into 2^DigitBits bucket lists by one digit of the
+// key, appending at the bucket's tail, then chains the buckets back
+// together. Every pass is a walk through nodes in memory-random order, so
+// wide digits (two passes for 32-bit keys) beat cheap ones; for short lists
+// DigitBits = 8 avoids setting up 64K buckets. A first pass counts every
+// digit, so digits that are the same in all keys (e.g. the high bits of
+// small values) are skipped.
+template <typename NodeT, int DigitBits = 16>
+void radixSortList(NodeT *&head)
+{
+    typedef typename std::decay<decltype(head->data)>::type Value;
+    static_assert(std::is_integral<Value>::value, "radixSortList needs integral data");
+    typedef typename std::make_unsigned<Value>::type Key;
+    const int keyBits = 8 * sizeof(Key);
+    const int digits = (keyBits + DigitBits - 1) / DigitBits;
+    const std::size_t buckets = (std::size_t)1 << DigitBits;
+    const Key flip = std::is_signed<Value>::value ? (Key)((Key)1 << (keyBits - 1)) : 0;
+    auto digitOf = [flip](const NodeT *node, int d)
+    { return (std::size_t)(((Key)((Key)node->data ^ flip) >> (DigitBits * d)) & (((Key)1 << DigitBits) - 1)); };
+
+    if (head == nullptr)
+    {
+        return;
+    }
+    std::vector<std::size_t> counts(digits * buckets);
+    std::size_t n = 0;
+    for (NodeT *node = head; node != nullptr; node = node->next)
+    {
+        for (int d = 0; d < digits; ++d)
+        {
+            ++counts[d * buckets + digitOf(node, d)];
+        }
+        ++n;
+    }
+
+    std::vector<NodeT *> bucketHead(buckets);
+    std::vector<NodeT **> bucketTail(buckets);
+    for (int d = 0; d < digits; ++d)
+    {
+        if (counts[d * buckets + digitOf(head, d)] == n)
+        {
+            continue;
+        }
+        for (std::size_t b = 0; b < buckets; ++b)
+        {
+            bucketHead[b] = nullptr;
+            bucketTail[b] = &bucketHead[b];
+        }
+        for (NodeT *node = head; node != nullptr; node = node->next)
+        {
+            std::size_t b = digitOf(node, d);
+            *bucketTail[b] = node;
+            bucketTail[b] = &node->next;
+        }
+        NodeT **link = &head;
+        for (std::size_t b = 0; b < buckets; ++b)
+        {
+            if (bucketHead[b] != nullptr)
+            {
+                *link = bucketHead[b];
+                link = bucketTail[b];
+            }
+        }
+        *link = nullptr;
+    }
+}
+
+#endif // LIST_SORT_H
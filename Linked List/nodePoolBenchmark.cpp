@@ -0,0 +1,190 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "node_pool.h"
+#include "list_node.h"
+#include "../bench/bench_util.h"
+
+using namespace std;
+
+// Insert / delete churn on singly linked lists with nodes from global new /
+// delete versus the calling thread's NodePool. Every thread owns 1024 lists:
+//   build   push `nodes / threads` nodes onto random lists
+//   churn   `ops / threads` random push-front / pop-front on random lists
+//   free    delete every node one by one (and, for the pool, a bulk
+//           release() instead)
+// Each variant runs in its own process so the resident set sizes (RSS, from
+// /proc/self/statm) are not polluted by the other one. A variant fails if
+// its process does not exit cleanly, or if a thread's pool does not count
+// exactly the nodes it holds after the churn and none after the free phase.
+//
+// Usage: ./nodePoolBenchmark [nodes] [ops] [threads]   (default 4000000 20000000 hardware threads)
+
+template <typename Alloc>
+void insertAtBeginning(Node *&head, int val, Alloc alloc)
+{
+    Node *newNode = alloc.create(val);
+    newNode->next = head;
+    head = newNode;
+}
+
+template <typename Alloc>
+void deleteAtBeginning(Node *&head, Alloc alloc)
+{
+    Node *temp = head;
+    head = head->next;
+    alloc.destroy(temp);
+}
+
+// Whether the allocator's pool holds exactly `live` nodes; new / delete
+// keeps no count.
+bool liveNodesAre(const HeapAllocator<Node> &, size_t) { return true; }
+bool liveNodesAre(const PoolAllocator<Node> &alloc, size_t live) { return alloc.pool->liveCount() == live; }
+
+// Returns whether every thread's pool counted the nodes it holds after the
+// churn and none after the free phase.
+template <typename Alloc>
+bool run(const string &name, size_t nodes, size_t ops, unsigned threads, bool bulkRelease)
+{
+    benchSection(name);
+    const size_t listsPerThread = 1024;
+    vector<vector<Node *>> lists(threads, vector<Node *>(listsPerThread, nullptr));
+    // Pools are per thread, so the same workers run every phase (and stay
+    // alive until the last RSS reading); the main thread starts each phase
+    // and times it until all workers are done.
+    atomic<int> phase(-1);
+    atomic<unsigned> done(0);
+    vector<char> counted(threads, 0);
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            Alloc alloc;
+            uint64_t state = 0x9E3779B97F4A7C15ull * (t + 1);
+            auto next = [&]()
+            {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                return state;
+            };
+            size_t live = 0;
+            bool ok = true;
+            for (int p = 0; p < 3; p++)
+            {
+                while (phase.load() < p)
+                    this_thread::yield();
+                if (p == 0)
+                {
+                    for (size_t i = 0; i < nodes / threads; i++)
+                        insertAtBeginning(lists[t][next() % listsPerThread], (int)i, alloc);
+                    live += nodes / threads;
+                }
+                else if (p == 1)
+                {
+                    for (size_t i = 0; i < ops / threads; i++)
+                    {
+                        Node *&head = lists[t][next() % listsPerThread];
+                        if ((state >> 40) & 1 || head == nullptr)
+                        {
+                            insertAtBeginning(head, (int)i, alloc);
+                            live++;
+                        }
+                        else
+                        {
+                            deleteAtBeginning(head, alloc);
+                            live--;
+                        }
+                    }
+                    ok = liveNodesAre(alloc, live);
+                }
+                else if (bulkRelease)
+                {
+                    NodePool<Node>::local().release();
+                    for (Node *&head : lists[t])
+                        head = nullptr;
+                }
+                else
+                {
+                    for (Node *&head : lists[t])
+                        while (head != nullptr)
+                            deleteAtBeginning(head, alloc);
+                }
+                done++;
+            }
+            counted[t] = ok && liveNodesAre(alloc, 0);
+            while (phase.load() < 3)
+                this_thread::yield(); });
+    }
+
+    const char *labels[] = {"  build", "  churn", bulkRelease ? "  bulk release" : "  free"};
+    size_t counts[] = {nodes, ops, nodes};
+    for (int p = 0; p < 3; p++)
+    {
+        auto start = chrono::steady_clock::now();
+        phase.store(p);
+        while (done.load() < threads * (p + 1))
+            this_thread::yield();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        report(labels[p], {{(double)counts[p], "ops", 0}, {seconds * 1e9 / counts[p], "ns/op"}, {residentMiB(), "MiB RSS", 1}}, 24);
+    }
+    phase.store(3);
+    for (thread &worker : workers)
+        worker.join();
+    return find(counted.begin(), counted.end(), 0) == counted.end();
+}
+
+// Runs one variant in a child process; false if it failed its checks or
+// did not exit normally.
+template <typename F>
+bool isolated(F body)
+{
+    cout.flush();
+    pid_t child = fork();
+    if (child == 0)
+    {
+        bool ok = body();
+        if (!ok)
+            cout << "  checks: FAILED" << endl;
+        cout.flush();
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    cout << endl;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t nodes = argc > 1 ? strtoull(argv[1], nullptr, 10) : 4000000;
+    size_t ops = argc > 2 ? strtoull(argv[2], nullptr, 10) : 20000000;
+    unsigned threads = argc > 3 ? atoi(argv[3]) : thread::hardware_concurrency();
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+    cout << "baseline RSS " << fixed << setprecision(1) << residentMiB() << " MiB, " << threads << " threads" << endl
+         << endl;
+
+    bool ok = isolated([&]()
+                       { return run<HeapAllocator<Node>>("new/delete", nodes, ops, threads, false); });
+    ok = isolated([&]()
+                  { return run<PoolAllocator<Node>>("NodePool", nodes, ops, threads, false); }) &&
+         ok;
+    ok = isolated([&]()
+                  { return run<PoolAllocator<Node>>("NodePool with release()", nodes, ops, threads, true); }) &&
+         ok;
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Fixed-size allocator for list nodes.
+//
+// NodePool<T> carves cells of sizeof(T) out of large slabs and recycles freed
+// cells through an intrusive free list, so allocating or freeing a node is a
+// couple of pointer moves: no malloc call, no per-node header, and nodes
+// allocated together sit next to each other in memory. release() returns all
+// slabs at once, which frees a whole list without walking it.
+//
+// A pool is not synchronized. NodePool<T>::local() gives every thread its own
+// pool (its own free list), so threads never contend; a node must be freed to
+// the pool it came from. A pool destroyed with nodes still allocated keeps
+// its slabs rather than leave those nodes dangling.
+//
+// The lists take an allocator handle with create(args...) / destroy(node):
+// HeapAllocator<T> is plain new / delete, PoolAllocator<T> draws from a
+// NodePool (the calling thread's by default).
+template <typename T>
+class NodePool
+{
+private:
+    union Cell
+    {
+        Cell *next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<Cell *> slabs;
+    Cell *freeList = nullptr;
+    Cell *bump = nullptr;
+    Cell *bumpEnd = nullptr;
+    std::size_t nextSlabCells = 256;
+    std::size_t maxSlabCells;
+    std::size_t reservedCells = 0;
+    std::size_t live = 0;
+
+    // Slabs double up to maxSlabCells: small lists stay small, and big
+    // slabs are large enough for malloc to map them directly, so release()
+    // hands the memory back to the system.
+    void addSlab()
+    {
+        Cell *slab = static_cast<Cell *>(::operator new(nextSlabCells * sizeof(Cell)));
+        slabs.push_back(slab);
+        bump = slab;
+        bumpEnd = slab + nextSlabCells;
+        reservedCells += nextSlabCells;
+        if (nextSlabCells < maxSlabCells)
+        {
+            nextSlabCells *= 2;
+        }
+    }
+
+public:
+    explicit NodePool(std::size_t maxSlabCells = 65536) : maxSlabCells(maxSlabCells) {}
+
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    ~NodePool()
+    {
+        if (live == 0)
+        {
+            release();
+        }
+    }
+
+    // The calling thread's pool.
+    static NodePool &local()
+    {
+        static thread_local NodePool pool;
+        return pool;
+    }
+
+    void *allocate()
+    {
+        ++live;
+        if (freeList != nullptr)
+        {
+            Cell *cell = freeList;
+            freeList = cell->next;
+            return cell;
+        }
+        if (bump == bumpEnd)
+        {
+            addSlab();
+        }
+        return bump++;
+    }
+
+    void deallocate(void *p)
+    {
+        Cell *cell = static_cast<Cell *>(p);
+        cell->next = freeList;
+        freeList = cell;
+        --live;
+    }
+
+    template <typename... Args>
+    T *create(Args &&...args)
+    {
+        void *p = allocate();
+        try
+        {
+            return new (p) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(p);
+            throw;
+        }
+    }
+
+    void destroy(T *node)
+    {
+        node->~T();
+        deallocate(node);
+    }
+
+    // Frees every slab. Nodes still allocated become invalid without their
+    // destructors running, so use it for trivially destructible nodes, e.g.
+    // to drop a whole list instead of deleting it node by node.
+    void release()
+    {
+        for (Cell *slab : slabs)
+        {
+            ::operator delete(slab);
+        }
+        slabs.clear();
+        freeList = bump = bumpEnd = nullptr;
+        nextSlabCells = 256;
+        reservedCells = 0;
+        live = 0;
+    }
+
+    std::size_t liveCount() const { return live; }
+    std::size_t bytesReserved() const { return reservedCells * sizeof(Cell); }
+};
+
+template <typename T>
+struct HeapAllocator
+{
+    template <typename... Args>
+    T *create(Args &&...args) const { return new T(std::forward<Args>(args)...); }
+    void destroy(T *node) const { delete node; }
+};
+
+template <typename T>
+struct PoolAllocator
+{
+    NodePool<T> *pool;
+
+    PoolAllocator() : pool(&NodePool<T>::local()) {}
+    explicit PoolAllocator(NodePool<T> &pool) : pool(&pool) {}
+
+    template <typename... Args>
+    T *create(Args &&...args) const { return pool->create(std::forward<Args>(args)...); }
+    void destroy(T *node) const { pool->destroy(node); }
+};
+
+#endif // NODE_POOL_H
@@ -0,0 +1,309 @@
+#ifndef SINGLY_LINKED_LIST_H
+#define SINGLY_LINKED_LIST_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "node_pool.h"
+
+// Singly linked list that keeps its head, tail and length.
+//
+// The free functions in LinkedList.cpp / function.cpp only know the head, so
+// appending walks the whole list and counting nodes is O(n): building a list
+// with insertAtEnd is quadratic. This class keeps a tail pointer and a size,
+// so pushBack, size() and appending another list (splice) are O(1), and
+// append(first, last) is linear in the range only.
+//
+// Iterators are forward iterators over the values, usable with <algorithm>
+// and range-for. Insertion / erasure are "after" a position, as in
+// std::forward_list; beforeBegin() names the position before the first
+// node. Removing the last node is still O(n) (its predecessor has to be
+// found), so there is no popBack.
+//
+// Nodes come from Alloc<Node> (node_pool.h): HeapAllocator by default,
+// PoolAllocator to draw them from the calling thread's NodePool.
+template <typename T, template <typename> class Alloc = HeapAllocator>
+class SinglyLinkedList
+{
+private:
+    struct Link
+    {
+        Link *next = nullptr;
+    };
+
+public:
+    struct Node : Link
+    {
+        T data;
+
+        template <typename... Args>
+        explicit Node(Args &&...args) : data(std::forward<Args>(args)...) {}
+    };
+
+private:
+    // beforeBegin() is the anchor, and tail points at it while the list is
+    // empty, so inserting at the front or back needs no special case.
+    Link anchor;
+    Link *tail = &anchor;
+    std::size_t count = 0;
+    Alloc<Node> alloc;
+
+    static Node *asNode(Link *link) { return static_cast<Node *>(link); }
+
+    void linkAfter(Link *prev, Link *node)
+    {
+        node->next = prev->next;
+        prev->next = node;
+        if (prev == tail)
+        {
+            tail = node;
+        }
+        ++count;
+    }
+
+    // Takes over other's chain, leaving other empty.
+    void steal(SinglyLinkedList &other)
+    {
+        anchor.next = other.anchor.next;
+        tail = other.count == 0 ? &anchor : other.tail;
+        count = other.count;
+        other.anchor.next = nullptr;
+        other.tail = &other.anchor;
+        other.count = 0;
+    }
+
+public:
+    template <bool Const>
+    class Iterator
+    {
+    private:
+        Link *link;
+        friend class SinglyLinkedList;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const T *, T *>::type pointer;
+        typedef typename std::conditional<Const, const T &, T &>::type reference;
+
+        Iterator(Link *link = nullptr) : link(link) {}
+        // iterator converts to const_iterator
+        template <bool C, typename = typename std::enable_if<Const && !C>::type>
+        Iterator(const Iterator<C> &other) : link(other.link) {}
+
+        reference operator*() const { return asNode(link)->data; }
+        pointer operator->() const { return &asNode(link)->data; }
+        Iterator &operator++()
+        {
+            link = link->next;
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator before = *this;
+            link = link->next;
+            return before;
+        }
+        friend bool operator==(const Iterator &a, const Iterator &b) { return a.link == b.link; }
+        friend bool operator!=(const Iterator &a, const Iterator &b) { return a.link != b.link; }
+    };
+
+    typedef T value_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    explicit SinglyLinkedList(const Alloc<Node> &alloc = Alloc<Node>()) : alloc(alloc) {}
+
+    template <typename InputIt>
+    SinglyLinkedList(InputIt first, InputIt last, const Alloc<Node> &alloc = Alloc<Node>()) : alloc(alloc)
+    {
+        append(first, last);
+    }
+
+    SinglyLinkedList(std::initializer_list<T> values) { append(values.begin(), values.end()); }
+
+    SinglyLinkedList(const SinglyLinkedList &other) : alloc(other.alloc) { append(other.begin(), other.end()); }
+
+    SinglyLinkedList(SinglyLinkedList &&other) noexcept : alloc(other.alloc) { steal(other); }
+
+    SinglyLinkedList &operator=(const SinglyLinkedList &other)
+    {
+        if (this != &other)
+        {
+            clear();
+            alloc = other.alloc;
+            append(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SinglyLinkedList &operator=(SinglyLinkedList &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            alloc = other.alloc;
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~SinglyLinkedList() { clear(); }
+
+    iterator beforeBegin() { return iterator(&anchor); }
+    const_iterator beforeBegin() const { return const_iterator(const_cast<Link *>(&anchor)); }
+    iterator begin() { return iterator(anchor.next); }
+    iterator end() { return iterator(nullptr); }
+    const_iterator begin() const { return const_iterator(anchor.next); }
+    const_iterator end() const { return const_iterator(nullptr); }
+    // Position of the last node (beforeBegin() if empty): insertAfter(last(),
+    // x) appends.
+    iterator last() { return iterator(tail); }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    T &front() { return asNode(anchor.next)->data; }
+    const T &front() const { return asNode(anchor.next)->data; }
+    T &back() { return asNode(tail)->data; }
+    const T &back() const { return asNode(tail)->data; }
+
+    template <typename... Args>
+    T &emplaceFront(Args &&...args)
+    {
+        Node *node = alloc.create(std::forward<Args>(args)...);
+        linkAfter(&anchor, node);
+        return node->data;
+    }
+
+    template <typename... Args>
+    T &emplaceBack(Args &&...args)
+    {
+        Node *node = alloc.create(std::forward<Args>(args)...);
+        linkAfter(tail, node);
+        return node->data;
+    }
+
+    void pushFront(const T &value) { emplaceFront(value); }
+    void pushBack(const T &value) { emplaceBack(value); }
+    // Standard spelling, so std::back_inserter works.
+    void push_back(const T &value) { emplaceBack(value); }
+
+    void popFront() { eraseAfter(beforeBegin()); }
+
+    // Inserts value after pos and returns an iterator to it.
+    iterator insertAfter(const_iterator pos, const T &value)
+    {
+        Node *node = alloc.create(value);
+        linkAfter(pos.link, node);
+        return iterator(node);
+    }
+
+    // Removes the node after pos and returns an iterator to the one that
+    // followed it.
+    iterator eraseAfter(const_iterator pos)
+    {
+        Link *prev = pos.link;
+        Link *node = prev->next;
+        prev->next = node->next;
+        if (node == tail)
+        {
+            tail = prev;
+        }
+        --count;
+        alloc.destroy(asNode(node));
+        return iterator(prev->next);
+    }
+
+    // Appends copies of [first, last): linear in the range, whatever the
+    // length of the list.
+    template <typename InputIt>
+    void append(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+        {
+            Node *node = alloc.create(*first);
+            tail->next = node;
+            tail = node;
+            ++count;
+        }
+    }
+
+    // Moves every node of other after pos, in order, leaving other empty.
+    // O(1): no node is copied or visited. The nodes change owner, so both
+    // lists must allocate from the same place (the same pool).
+    void splice(const_iterator pos, SinglyLinkedList &other)
+    {
+        if (other.count == 0 || &other == this)
+        {
+            return;
+        }
+        Link *prev = pos.link;
+        other.tail->next = prev->next;
+        prev->next = other.anchor.next;
+        if (prev == tail)
+        {
+            tail = other.tail;
+        }
+        count += other.count;
+        other.anchor.next = nullptr;
+        other.tail = &other.anchor;
+        other.count = 0;
+    }
+
+    // Moves every node of other to the end of this list. O(1).
+    void splice(SinglyLinkedList &other) { splice(last(), other); }
+
+    void reverse()
+    {
+        Link *prev = nullptr;
+        Link *current = anchor.next;
+        if (current != nullptr)
+        {
+            tail = current;
+        }
+        while (current != nullptr)
+        {
+            Link *next = current->next;
+            current->next = prev;
+            prev = current;
+            current = next;
+        }
+        anchor.next = prev;
+    }
+
+    void clear()
+    {
+        Link *link = anchor.next;
+        while (link != nullptr)
+        {
+            Link *next = link->next;
+            alloc.destroy(asNode(link));
+            link = next;
+        }
+        anchor.next = nullptr;
+        tail = &anchor;
+        count = 0;
+    }
+
+    // First position holding value, or end().
+    iterator find(const T &value)
+    {
+        for (Link *link = anchor.next; link != nullptr; link = link->next)
+        {
+            if (asNode(link)->data == value)
+            {
+                return iterator(link);
+            }
+        }
+        return end();
+    }
+};
+
+#endif // SINGLY_LINKED_LIST_H
@@ -0,0 +1,228 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <cstdlib>
+#include <stdexcept>
+#include "unrolled_linked_list.h"
+#include "list_node.h"
+#include "../bench/bench_util.h"
+
+using namespace std;
+
+// Sequential scans over n ints: the Node list of LinkedList.cpp versus
+// UnrolledLinkedList at several chunk sizes.
+//   scan     sum every element (traverse without the printing)
+//   search   `searches` lookups of absent values, each a full scan
+//   reverse  reverse the whole list in place
+// The Node list is measured twice: nodes linked in allocation order (the
+// best case, right after building) and in shuffled order (what a list
+// looks like after a while of inserts and deletes in the middle). The
+// memory column is bytes per element, including allocator headers for the
+// Node list (16 bytes of node + 16 of malloc overhead, estimated).
+//
+// Before timing, checkAgainstVector() runs random inserts, deletes and
+// reverses on small-chunk lists (so splits and refills happen often) and
+// compares the contents with a std::vector after every step.
+//
+// Usage: ./unrolledListBenchmark [n] [searches]   (default 4000000 20)
+
+// search and reverse as LinkedList.cpp defines them.
+bool search(Node *head, int key)
+{
+    for (Node *temp = head; temp != nullptr; temp = temp->next)
+        if (temp->data == key)
+            return true;
+    return false;
+}
+
+void reverse(Node *&head)
+{
+    Node *prev = nullptr, *current = head;
+    while (current != nullptr)
+    {
+        Node *next = current->next;
+        current->next = prev;
+        prev = current;
+        current = next;
+    }
+    head = prev;
+}
+
+void report(const string &label, size_t n, double scan, double search, double reverse, double bytesPerElement)
+{
+    report(label, {{scan * 1e9 / n, "ns scan"}, {search * 1e9 / n, "ns search"}, {reverse * 1e9 / n, "ns reverse"}, {bytesPerElement, "bytes", 1}}, 26);
+}
+
+bool runNodes(const string &label, const vector<int> &values, size_t searches, bool shuffled)
+{
+    size_t n = values.size();
+    vector<Node *> nodes(n);
+    for (size_t i = 0; i < n; i++)
+        nodes[i] = new Node(0);
+    if (shuffled)
+        shuffle(nodes.begin(), nodes.end(), mt19937(5));
+    for (size_t i = 0; i < n; i++)
+    {
+        nodes[i]->data = values[i];
+        nodes[i]->next = i + 1 < n ? nodes[i + 1] : nullptr;
+    }
+    Node *head = n ? nodes[0] : nullptr;
+
+    long long sum = 0;
+    double scan = timeIt([&]()
+                         {
+        for (Node *temp = head; temp != nullptr; temp = temp->next)
+            sum += temp->data; });
+    bool found = false;
+    double searching = timeIt([&]()
+                              {
+        for (size_t s = 0; s < searches; s++)
+            found = search(head, -1 - (int)s) || found; });
+    double reversing = timeIt([&]()
+                              { reverse(head); });
+    report(label, n, scan, searching / searches, reversing, 32);
+
+    bool ok = !found && head == (n ? nodes[n - 1] : nullptr);
+    for (Node *node : nodes)
+        delete node;
+    return ok && sum == accumulate(values.begin(), values.end(), 0LL);
+}
+
+template <size_t ChunkSize>
+bool runUnrolled(const vector<int> &values, size_t searches)
+{
+    size_t n = values.size();
+    UnrolledLinkedList<int, ChunkSize> list;
+    for (int value : values)
+        list.insertAtEnd(value);
+
+    long long sum = 0;
+    double scan = timeIt([&]()
+                         { list.forEach([&](int value)
+                                        { sum += value; }); });
+    bool found = false;
+    double searching = timeIt([&]()
+                              {
+        for (size_t s = 0; s < searches; s++)
+            found = list.search(-1 - (int)s) || found; });
+    double reversing = timeIt([&]()
+                              { list.reverse(); });
+    double bytes = (double)list.chunkCount() * (sizeof(typename UnrolledLinkedList<int, ChunkSize>::Chunk) + 16) / n;
+    report("unrolled chunk " + to_string(ChunkSize), n, scan, searching / searches, reversing, bytes);
+
+    bool ok = !found && sum == accumulate(values.begin(), values.end(), 0LL);
+    const UnrolledLinkedList<int, ChunkSize> &view = list;
+    ok = ok && n > 0 && view.at(0) == values[n - 1] && view.at(n - 1) == values[0];
+    try
+    {
+        view.at(n);
+        ok = false;
+    }
+    catch (const out_of_range &)
+    {
+    }
+    return ok;
+}
+
+// Random operations on an UnrolledLinkedList and a std::vector, comparing
+// the contents, length and chunk occupancy after each one. Values come from
+// a small range so deleteByValue both hits and misses.
+template <size_t ChunkSize>
+bool checkAgainstVector(size_t steps, unsigned seed)
+{
+    UnrolledLinkedList<int, ChunkSize> list;
+    vector<int> model, contents;
+    mt19937 rng(seed);
+    for (size_t step = 0; step < steps; step++)
+    {
+        int value = (int)(rng() % 64);
+        // Grow while small, shrink while large, so sizes sweep 0..~200.
+        bool grow = rng() % 200 >= model.size();
+        size_t position = rng() % (model.size() + 2);
+        switch (rng() % 4 + (grow ? 0 : 4))
+        {
+        case 0:
+            list.insertAtBeginning(value);
+            model.insert(model.begin(), value);
+            break;
+        case 1:
+            list.insertAtEnd(value);
+            model.push_back(value);
+            break;
+        case 2:
+        case 3:
+            if (list.insertAt(position, value) != (position <= model.size()))
+                return false;
+            if (position <= model.size())
+                model.insert(model.begin() + position, value);
+            break;
+        case 4:
+            list.deleteAtBeginning();
+            if (!model.empty())
+                model.erase(model.begin());
+            break;
+        case 5:
+            list.deleteAtEnd();
+            if (!model.empty())
+                model.pop_back();
+            break;
+        case 6:
+        {
+            vector<int>::iterator found = find(model.begin(), model.end(), value);
+            if (list.deleteByValue(value) != (found != model.end()))
+                return false;
+            if (found != model.end())
+                model.erase(found);
+            break;
+        }
+        default:
+            if (list.deleteByPosition(position) != (position < model.size()))
+                return false;
+            if (position < model.size())
+                model.erase(model.begin() + position);
+            break;
+        }
+        if (step % 97 == 0)
+        {
+            list.reverse();
+            std::reverse(model.begin(), model.end());
+        }
+
+        contents.clear();
+        list.forEach([&](int element)
+                     { contents.push_back(element); });
+        size_t chunks = list.chunkCount();
+        if (contents != model || list.length() != model.size() ||
+            (chunks > 0 && (chunks - 1) * (ChunkSize / 2) > model.size()) ||
+            (!model.empty() && list.at(position % model.size()) != model[position % model.size()]))
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 4000000;
+    size_t searches = argc > 2 ? strtoull(argv[2], nullptr, 10) : 20;
+    vector<int> values(n);
+    mt19937 rng(1);
+    for (int &value : values)
+        value = (int)(rng() % 1000000000);
+
+    bool ok = checkAgainstVector<2>(20000, 1) && checkAgainstVector<4>(20000, 2) && checkAgainstVector<8>(20000, 3);
+    cout << "random operations match std::vector: " << (ok ? "yes" : "no") << endl;
+
+    cout << n << " elements, ns and bytes per element" << endl;
+    ok = runNodes("Node list (in order)", values, searches, false) && ok;
+    ok = runNodes("Node list (shuffled)", values, searches, true) && ok;
+    ok = runUnrolled<8>(values, searches) && ok;
+    ok = runUnrolled<16>(values, searches) && ok;
+    ok = runUnrolled<32>(values, searches) && ok;
+    ok = runUnrolled<64>(values, searches) && ok;
+    ok = runUnrolled<128>(values, searches) && ok;
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
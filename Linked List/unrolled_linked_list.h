@@ -0,0 +1,365 @@
+#ifndef UNROLLED_LINKED_LIST_H
+#define UNROLLED_LINKED_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include "node_pool.h"
+
+// Unrolled linked list: a linked list of chunks, each holding up to
+// ChunkSize elements in an array plus an occupancy count.
+//
+// A plain Node list spends a pointer and usually a cache line per element,
+// and every step of a scan waits on the previous node's `next`. Here a scan
+// reads ChunkSize contiguous elements per pointer hop, so search, traverse
+// and reverse run at close to array speed, and the list costs one pointer
+// pair per chunk instead of one pointer per element.
+//
+// The API mirrors the Node functions in LinkedList.cpp / function.cpp
+// (insertAtBeginning / insertAtEnd / insertAt, deleteAtBeginning /
+// deleteAtEnd / deleteByValue / deleteByPosition, search, traverse, length,
+// reverse). Chunks are split when an insert finds them full and are
+// refilled from (or merged with) the next chunk when a delete leaves them
+// under half full, so every chunk but the last stays at least half full.
+// Inserting or deleting by position walks chunks, not elements.
+//
+// T must be default constructible and movable. Chunks come from
+// Alloc<Chunk> (node_pool.h).
+template <typename T, std::size_t ChunkSize = 32, template <typename> class Alloc = HeapAllocator>
+class UnrolledLinkedList
+{
+    static_assert(ChunkSize >= 2, "a chunk must hold at least two elements");
+
+public:
+    struct Chunk
+    {
+        Chunk *prev = nullptr;
+        Chunk *next = nullptr;
+        std::uint32_t count = 0;
+        T items[ChunkSize];
+    };
+
+private:
+    Chunk *head = nullptr;
+    Chunk *tail = nullptr;
+    std::size_t total = 0;
+    std::size_t chunks = 0;
+    Alloc<Chunk> alloc;
+
+    Chunk *newChunkAfter(Chunk *prev)
+    {
+        Chunk *chunk = alloc.create();
+        chunk->prev = prev;
+        chunk->next = prev != nullptr ? prev->next : head;
+        if (chunk->next != nullptr)
+        {
+            chunk->next->prev = chunk;
+        }
+        else
+        {
+            tail = chunk;
+        }
+        if (prev != nullptr)
+        {
+            prev->next = chunk;
+        }
+        else
+        {
+            head = chunk;
+        }
+        ++chunks;
+        return chunk;
+    }
+
+    void unlink(Chunk *chunk)
+    {
+        (chunk->prev != nullptr ? chunk->prev->next : head) = chunk->next;
+        (chunk->next != nullptr ? chunk->next->prev : tail) = chunk->prev;
+        alloc.destroy(chunk);
+        --chunks;
+    }
+
+    // Moves the upper half of a full chunk into a new chunk after it.
+    void split(Chunk *chunk)
+    {
+        Chunk *right = newChunkAfter(chunk);
+        std::uint32_t keep = (std::uint32_t)(ChunkSize / 2);
+        std::move(chunk->items + keep, chunk->items + chunk->count, right->items);
+        right->count = chunk->count - keep;
+        chunk->count = keep;
+    }
+
+    // Inserts value at index i (0..count) of chunk, splitting it first if
+    // it is full.
+    void insertInto(Chunk *chunk, std::size_t i, const T &value)
+    {
+        if (chunk->count == ChunkSize)
+        {
+            split(chunk);
+            if (i > chunk->count)
+            {
+                i -= chunk->count;
+                chunk = chunk->next;
+            }
+        }
+        std::move_backward(chunk->items + i, chunk->items + chunk->count, chunk->items + chunk->count + 1);
+        chunk->items[i] = value;
+        ++chunk->count;
+        ++total;
+    }
+
+    // Removes element i of chunk, then restores the half-full invariant.
+    void eraseFrom(Chunk *chunk, std::size_t i)
+    {
+        std::move(chunk->items + i + 1, chunk->items + chunk->count, chunk->items + i);
+        --chunk->count;
+        --total;
+        refill(chunk);
+    }
+
+    // Brings a chunk under half full back to half full by borrowing from or
+    // merging with the next chunk, which must be at least half full itself
+    // unless it is the last. A last chunk is only unlinked once empty.
+    void refill(Chunk *chunk)
+    {
+        if (chunk->count >= ChunkSize / 2)
+        {
+            return;
+        }
+        Chunk *next = chunk->next;
+        if (next == nullptr)
+        {
+            if (chunk->count == 0)
+            {
+                unlink(chunk);
+            }
+            return;
+        }
+        if (chunk->count + next->count <= ChunkSize)
+        {
+            std::move(next->items, next->items + next->count, chunk->items + chunk->count);
+            chunk->count += next->count;
+            unlink(next);
+        }
+        else
+        {
+            std::uint32_t borrow = (std::uint32_t)(ChunkSize / 2) - chunk->count;
+            std::move(next->items, next->items + borrow, chunk->items + chunk->count);
+            std::move(next->items + borrow, next->items + next->count, next->items);
+            chunk->count += borrow;
+            next->count -= borrow;
+        }
+    }
+
+    // Chunk holding element `position`, and the index inside it.
+    std::pair<Chunk *, std::size_t> locate(std::size_t position) const
+    {
+        Chunk *chunk = head;
+        while (position >= chunk->count)
+        {
+            position -= chunk->count;
+            chunk = chunk->next;
+        }
+        return std::make_pair(chunk, position);
+    }
+
+public:
+    explicit UnrolledLinkedList(const Alloc<Chunk> &alloc = Alloc<Chunk>()) : alloc(alloc) {}
+
+    UnrolledLinkedList(const UnrolledLinkedList &other) : alloc(other.alloc)
+    {
+        for (const Chunk *chunk = other.head; chunk != nullptr; chunk = chunk->next)
+        {
+            Chunk *copy = newChunkAfter(tail);
+            std::copy(chunk->items, chunk->items + chunk->count, copy->items);
+            copy->count = chunk->count;
+        }
+        total = other.total;
+    }
+
+    UnrolledLinkedList &operator=(UnrolledLinkedList other)
+    {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(total, other.total);
+        std::swap(chunks, other.chunks);
+        std::swap(alloc, other.alloc);
+        return *this;
+    }
+
+    ~UnrolledLinkedList() { clear(); }
+
+    std::size_t length() const { return total; }
+    bool empty() const { return total == 0; }
+    std::size_t chunkCount() const { return chunks; }
+    // Filled fraction of the allocated element slots.
+    double occupancy() const { return chunks ? (double)total / (chunks * ChunkSize) : 0.0; }
+
+    void insertAtBeginning(const T &value)
+    {
+        insertInto(head != nullptr ? head : newChunkAfter(nullptr), 0, value);
+    }
+
+    void insertAtEnd(const T &value)
+    {
+        // A full tail gets a fresh chunk instead of a split, so building a
+        // list by appending packs every chunk full.
+        Chunk *chunk = tail != nullptr && tail->count < ChunkSize ? tail : newChunkAfter(tail);
+        chunk->items[chunk->count++] = value;
+        ++total;
+    }
+
+    // Inserts value so that it becomes element `position` (0..length()).
+    // Returns false if position is out of range.
+    bool insertAt(std::size_t position, const T &value)
+    {
+        if (position > total)
+        {
+            return false;
+        }
+        if (position == total)
+        {
+            insertAtEnd(value);
+            return true;
+        }
+        std::pair<Chunk *, std::size_t> at = locate(position);
+        insertInto(at.first, at.second, value);
+        return true;
+    }
+
+    void deleteAtBeginning()
+    {
+        if (head != nullptr)
+        {
+            eraseFrom(head, 0);
+        }
+    }
+
+    void deleteAtEnd()
+    {
+        if (tail == nullptr)
+        {
+            return;
+        }
+        --tail->count;
+        --total;
+        if (tail->count == 0)
+        {
+            unlink(tail);
+        }
+    }
+
+    // Deletes the first element equal to value. Returns false if absent.
+    bool deleteByValue(const T &value)
+    {
+        for (Chunk *chunk = head; chunk != nullptr; chunk = chunk->next)
+        {
+            T *found = std::find(chunk->items, chunk->items + chunk->count, value);
+            if (found != chunk->items + chunk->count)
+            {
+                eraseFrom(chunk, found - chunk->items);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool deleteByPosition(std::size_t position)
+    {
+        if (position >= total)
+        {
+            return false;
+        }
+        std::pair<Chunk *, std::size_t> at = locate(position);
+        eraseFrom(at.first, at.second);
+        return true;
+    }
+
+    bool search(const T &value) const
+    {
+        for (const Chunk *chunk = head; chunk != nullptr; chunk = chunk->next)
+        {
+            if (std::find(chunk->items, chunk->items + chunk->count, value) != chunk->items + chunk->count)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Element at position, walking chunks. Throws std::out_of_range.
+    T &at(std::size_t position)
+    {
+        if (position >= total)
+        {
+            throw std::out_of_range("UnrolledLinkedList::at");
+        }
+        std::pair<Chunk *, std::size_t> where = locate(position);
+        return where.first->items[where.second];
+    }
+
+    const T &at(std::size_t position) const
+    {
+        if (position >= total)
+        {
+            throw std::out_of_range("UnrolledLinkedList::at");
+        }
+        std::pair<Chunk *, std::size_t> where = locate(position);
+        return where.first->items[where.second];
+    }
+
+    // Calls visit(element) in order.
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (const Chunk *chunk = head; chunk != nullptr; chunk = chunk->next)
+        {
+            for (std::uint32_t i = 0; i < chunk->count; ++i)
+            {
+                visit(chunk->items[i]);
+            }
+        }
+    }
+
+    void traverse(std::ostream &out = std::cout) const
+    {
+        forEach([&](const T &value)
+                { out << value << "->"; });
+        out << "nullptr" << std::endl;
+    }
+
+    // Reverses the chunk order and each chunk's elements. The old last
+    // chunk, which may be under half full, becomes the head, so it is
+    // refilled from the chunk after it.
+    void reverse()
+    {
+        for (Chunk *chunk = head; chunk != nullptr; chunk = chunk->prev)
+        {
+            std::swap(chunk->prev, chunk->next);
+            std::reverse(chunk->items, chunk->items + chunk->count);
+        }
+        std::swap(head, tail);
+        if (head != nullptr)
+        {
+            refill(head);
+        }
+    }
+
+    void clear()
+    {
+        while (head != nullptr)
+        {
+            Chunk *next = head->next;
+            alloc.destroy(head);
+            head = next;
+        }
+        tail = nullptr;
+        total = 0;
+        chunks = 0;
+    }
+};
+
+#endif // UNROLLED_LINKED_LIST_H
@@ -49,7 +49,6 @@ int main()
 
     // Test Case 2: Edge case - Array is empty
     vector<int> arr2 = {};
-    int K2 = 3;
 
     // Test Case 3: Edge case - K is 0 or negative
     vector<int> arr3 = {1, 2, 3};
@@ -44,7 +44,7 @@ public:
         if (top == -1)
         {
             cout << "Stack is empty!.";
-            return;
+            return -1;
         }
         return arr[top];
     }
@@ -1,46 +1,15 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include "../../sorting/cpp/parallel_sort.h"
 
 using namespace std;
 
-void heapify(vector<int> &arr, int n, int i)
-{
-
-    int largest = i;
-    int left = 2 * i + 1;
-    int right = 2 * i + 2;
-
-    if (left < n && arr[left] > arr[largest])
-    {
-        largest = left;
-    }
-    if (right < n && arr[right] > arr[largest])
-    {
-        largest = right;
-    }
-
-    if (largest != i)
-    {
-        swap(arr[i], arr[largest]);
-        heapify(arr, n, largest);
-    }
-}
-
+// Iterative heap sort from the sorting module: no recursion, and a 4-ary
+// heap keeps each sibling group in one cache line.
 void heapSort(vector<int> &arr)
 {
-    int n = arr.size();
-
-    for (int i = n / 2 - 1; i >= 0; i--)
-    {
-        heapify(arr, n, i);
-    }
-
-    for (int i = n - 1; i >= 1; i--)
-    {
-        swap(arr[0], arr[i]);
-        heapify(arr, i, 0);
-    }
+    heapSort(arr.begin(), arr.end(), less<int>());
 }
 
 int main()
@@ -60,5 +29,14 @@ int main()
         cout << num << " ";
     }
     cout << endl;
+
+    vector<double> values = {3.5, -1.25, 9.0, 0.5, 7.75, 2.0};
+    parallelSort(values.begin(), values.end(), greater<double>());
+    cout << "Sorted descending: ";
+    for (double value : values)
+    {
+        cout << value << " ";
+    }
+    cout << endl;
     return 0;
 }
\ No newline at end of file
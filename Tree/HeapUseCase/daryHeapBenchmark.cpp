@@ -0,0 +1,158 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <cstdlib>
+#include "../dary_heap.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Push n random keys, then pop them all. Compares std::priority_queue with the
+// DaryHeap engine at arity 2/4/8, plus the batched insertBatch/extractTopK path.
+// After each timed run an untimed run compares every pop (and the
+// extractTopK result) with a sorted copy of the keys.
+//
+// Usage: ./daryHeapBenchmark [maxExponent]   (default 8 -> sizes 1e4..1e8;
+// the 1e8 step needs ~1.2 GB of RAM: keys, sorted copy and heap)
+
+struct Task
+{
+    int priority;
+    int id;
+    bool operator<(const Task &other) const
+    {
+        return priority < other.priority;
+    }
+};
+
+static long long sink = 0;
+
+void report(const string &label, double seconds, size_t ops)
+{
+    report("  " + label, {{seconds * 1e9 / ops, "ns/op"}}, 32);
+}
+
+// Pushes keys into a fresh heap and checks that the pops come out as
+// expected (the keys sorted largest first); priorityOf maps an element to
+// its key.
+template <typename Heap, typename Make, typename Priority>
+bool popsInOrder(const vector<int> &keys, const vector<int> &expected, Make make, Priority priorityOf)
+{
+    Heap heap;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        heap.push(make(keys[i], (int)i));
+    }
+    for (int key : expected)
+    {
+        if (heap.empty() || priorityOf(heap.top()) != key)
+        {
+            return false;
+        }
+        heap.pop();
+    }
+    return heap.empty();
+}
+
+template <typename Heap>
+bool benchPushPop(const string &label, const vector<int> &keys, const vector<int> &expected)
+{
+    double seconds = timeIt([&]()
+                            {
+        Heap heap;
+        for (int key : keys)
+        {
+            heap.push(key);
+        }
+        while (!heap.empty())
+        {
+            sink += heap.top();
+            heap.pop();
+        } });
+    report(label, seconds, 2 * keys.size());
+    return popsInOrder<Heap>(
+        keys, expected, [](int key, int)
+        { return key; },
+        [](int key)
+        { return key; });
+}
+
+template <typename Heap>
+bool benchTaskPushPop(const string &label, const vector<int> &keys, const vector<int> &expected)
+{
+    double seconds = timeIt([&]()
+                            {
+        Heap heap;
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            heap.push(Task{keys[i], (int)i});
+        }
+        while (!heap.empty())
+        {
+            sink += heap.top().id;
+            heap.pop();
+        } });
+    report(label, seconds, 2 * keys.size());
+    return popsInOrder<Heap>(
+        keys, expected, [](int key, int id)
+        { return Task{key, id}; },
+        [](const Task &task)
+        { return task.priority; });
+}
+
+template <size_t Arity>
+bool benchBatch(const string &label, const vector<int> &keys, const vector<int> &expected)
+{
+    double seconds = timeIt([&]()
+                            {
+        DaryHeap<int, Arity> heap;
+        heap.insertBatch(keys);
+        vector<int> top = heap.extractTopK(keys.size());
+        sink += top.back(); });
+    report(label, seconds, 2 * keys.size());
+
+    // A partial extractTopK must return the prefix and leave the rest.
+    DaryHeap<int, Arity> heap;
+    heap.insertBatch(keys);
+    size_t k = keys.size() / 10;
+    vector<int> top = heap.extractTopK(k);
+    bool ok = equal(top.begin(), top.end(), expected.begin()) && top.size() == k && heap.size() == keys.size() - k;
+    vector<int> rest = heap.extractTopK(keys.size());
+    return ok && equal(rest.begin(), rest.end(), expected.begin() + k) && rest.size() == keys.size() - k && heap.empty();
+}
+
+int main(int argc, char *argv[])
+{
+    int maxExponent = argc > 1 ? atoi(argv[1]) : 8;
+    mt19937 rng(42);
+    bool ok = true;
+
+    size_t n = 10000;
+    for (int exponent = 4; exponent <= maxExponent; exponent++, n *= 10)
+    {
+        vector<int> keys(n);
+        for (int &key : keys)
+        {
+            key = (int)rng();
+        }
+        vector<int> expected(keys);
+        sort(expected.begin(), expected.end(), greater<int>());
+        benchSection(to_string(n) + " keys");
+
+        ok = benchPushPop<priority_queue<int>>("std::priority_queue<int>", keys, expected) && ok;
+        ok = benchPushPop<DaryHeap<int, 2>>("DaryHeap<int> d=2", keys, expected) && ok;
+        ok = benchPushPop<DaryHeap<int, 4>>("DaryHeap<int> d=4", keys, expected) && ok;
+        ok = benchPushPop<DaryHeap<int, 8>>("DaryHeap<int> d=8", keys, expected) && ok;
+        ok = benchTaskPushPop<priority_queue<Task>>("std::priority_queue<Task>", keys, expected) && ok;
+        ok = benchTaskPushPop<DaryHeap<Task, 4>>("DaryHeap<Task> d=4", keys, expected) && ok;
+        ok = benchBatch<4>("DaryHeap<int> d=4 batch", keys, expected) && ok;
+        ok = benchBatch<8>("DaryHeap<int> d=8 batch", keys, expected) && ok;
+    }
+
+    cout << "(checksum " << sink << ")" << endl;
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
@@ -1,30 +1,79 @@
 #include <iostream>
-#include <queue>
+#include <vector>
+#include <iterator>
+#include <sstream>
+#include <cstdlib>
+#include <functional>
+#include <climits>
+#include "../top_k.h"
 using namespace std;
 int findKthLargest(vector<int> &, int);
-int main()
+int findKthLargestStreaming(istream &, int);
+
+// Usage: ./kth            runs the examples below
+//        ./kth k < file   prints the k-th largest of the integers on stdin
+//                         without loading them into memory
+int main(int argc, char *argv[])
 {
+    if (argc > 1)
+    {
+        char *end;
+        long k = strtol(argv[1], &end, 10);
+        if (end == argv[1] || *end != '\0' || k < 1 || k > INT_MAX)
+        {
+            cerr << "Usage: " << argv[0] << " k < file   (k must be a positive integer)" << endl;
+            return 1;
+        }
+        cout << findKthLargestStreaming(cin, (int)k) << endl;
+        return 0;
+    }
+
     vector<int> nums = {3, 2, 1, 5, 6, 4};
     int k = 2;
     int result = findKthLargest(nums, k);
 
     cout << "The " << k << "-th largest elements is: " << result << endl;
+
+    istringstream stream("3 2 3 1 2 4 5 5 6");
+    cout << "The 4-th largest of the stream is: " << findKthLargestStreaming(stream, 4) << endl;
+
+    vector<int> values = {9, 1, 8, 2, 7, 3, 6, 4, 5};
+    cout << "Top 3 computed by 2 threads: ";
+    for (int value : parallelTopK(values.begin(), values.end(), 3, less<int>(), 2))
+    {
+        cout << value << " ";
+    }
+    cout << endl;
     return 0;
 }
 
+// In-memory path: Floyd-Rivest selection partially orders nums in place,
+// expected O(n) time and no extra memory (instead of heaping all n values).
 int findKthLargest(vector<int> &nums, int k)
 {
-    priority_queue<int> maxHeap;
-
-    for (int num : nums)
+    if (k < 1 || (size_t)k > nums.size())
     {
-        maxHeap.push(num);
+        cout << "k must be between 1 and " << nums.size() << endl;
+        return -1;
     }
+    floydRivestSelect(nums.begin(), nums.begin() + (k - 1), nums.end(), greater<int>());
+    return nums[k - 1];
+}
 
-    for (int i = 1; i < k; i++)
+// Streaming path: only a k-element min-heap is kept, O(n log k) time.
+int findKthLargestStreaming(istream &in, int k)
+{
+    if (k < 1)
     {
-        maxHeap.pop();
+        cout << "k must be at least 1" << endl;
+        return -1;
     }
-
-    return maxHeap.top();
-}
\ No newline at end of file
+    TopK<int> topK(k);
+    topK.offerRange(istream_iterator<int>(in), istream_iterator<int>());
+    if (!topK.full())
+    {
+        cout << "Fewer than " << k << " values in the input" << endl;
+        return -1;
+    }
+    return topK.kth();
+}
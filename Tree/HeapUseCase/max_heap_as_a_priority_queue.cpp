@@ -1,5 +1,9 @@
 #include <iostream>
 #include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../multi_queue.h"
 using namespace std;
 
 int main()
@@ -20,5 +24,34 @@ int main()
         maxHeap.pop();
     }
 
+    // Same pattern shared by several producer threads: a MultiQueue lets them
+    // push concurrently without serializing on one lock.
+    // One shard per producer; each pop samples 4 shards, so jobs come out
+    // roughly, not strictly, in priority order.
+    MultiQueue<int, string> jobs(4, 1, 4);
+    vector<thread> producers;
+    for (int p = 0; p < 4; p++)
+    {
+        producers.emplace_back([&jobs, p]()
+                               {
+            for (int j = 0; j < 3; j++)
+            {
+                int priority = (p * 3 + j) * 10;
+                jobs.push(priority, "job " + to_string(p) + "." + to_string(j));
+            } });
+    }
+    for (thread &producer : producers)
+    {
+        producer.join();
+    }
+
+    cout << "Scheduled jobs (relaxed priority order): " << endl;
+    int priority;
+    string job;
+    while (jobs.tryPop(priority, job))
+    {
+        cout << priority << " " << job << endl;
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include <cmath>
+#include "../sliding_quantile.h"
+#include "../t_digest.h"
 using namespace std;
 class MedianFinder
 {
@@ -44,6 +47,52 @@ public:
         }
     }
 };
+// MedianFinder over only the last windowSize numbers (and, when maxAge > 0,
+// only numbers added less than maxAge time units ago). Old numbers are
+// erased from the heaps in O(log n) instead of being kept forever. With a
+// maxAge, pass the current time to findMedian too, so numbers that aged
+// out while nothing was added are dropped before the median is read. A
+// quiet period longer than maxAge empties the window: findMedian then
+// returns NaN, and empty(now) tells that case apart up front.
+class WindowedMedianFinder
+{
+private:
+    SlidingQuantile<int> window;
+
+public:
+    WindowedMedianFinder(size_t windowSize, long long maxAge = 0) : window(0.5, windowSize, maxAge) {}
+    void addNum(int num, long long now = 0)
+    {
+        window.add(num, now);
+    }
+    bool empty(long long now)
+    {
+        window.expire(now);
+        return window.empty();
+    }
+    bool empty() const
+    {
+        return window.empty();
+    }
+    double findMedian(long long now)
+    {
+        window.expire(now);
+        return findMedian();
+    }
+    double findMedian()
+    {
+        if (window.empty())
+        {
+            return NAN;
+        }
+        if (window.size() % 2 == 1)
+        {
+            return window.value();
+        }
+        return (window.value() + window.upperValue()) / 2.0;
+    }
+};
+
 int main()
 {
 
@@ -53,5 +102,39 @@ int main()
     cout << "Median: " << mf.findMedian() << endl;
     mf.addNum(3);
     cout << "Median: " << mf.findMedian() << endl;
+
+    WindowedMedianFinder wmf(3);
+    for (int num : {5, 1, 9, 7, 2})
+    {
+        wmf.addNum(num);
+        cout << "Median of last 3 after " << num << ": " << wmf.findMedian() << endl;
+    }
+
+    // Median latency of the last 10 time units; the slow samples at t=0..2
+    // have aged out by t=12 even though nothing was added since t=5.
+    WindowedMedianFinder recent(100, 10);
+    long long t = 0;
+    for (int latency : {90, 80, 85, 10, 12, 11})
+    {
+        recent.addNum(latency, t++);
+    }
+    cout << "Median at t=5: " << recent.findMedian(5) << ", at t=12: " << recent.findMedian(12) << endl;
+    // Nothing added for longer than maxAge: every sample has aged out.
+    cout << "At t=30: " << (recent.empty(30) ? "no samples" : "samples") << ", median "
+         << recent.findMedian(30) << endl;
+
+    // p99 latency of the last 1000 requests, exact.
+    SlidingQuantile<double> p99(0.99, 1000);
+    // p50/p99/p999 of everything, approximate, in a few KB.
+    TDigest digest;
+    for (int i = 1; i <= 100000; i++)
+    {
+        double latencyMs = (i * 7919 % 1000) / 10.0;
+        p99.add(latencyMs);
+        digest.add(latencyMs);
+    }
+    cout << "Windowed p99: " << p99.value() << " ms" << endl;
+    cout << "Digest p50/p99/p999: " << digest.quantile(0.5) << " / " << digest.quantile(0.99)
+         << " / " << digest.quantile(0.999) << " ms" << endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <cstdlib>
+#include "../multi_queue.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Every thread alternates push / pop on a shared queue that is prefilled with
+// 1e6 items, for a fixed number of operations. Reports total throughput for
+// a mutex-wrapped std::priority_queue and MultiQueue with c = 2 and c = 4
+// queues per thread as the thread count doubles from 1 to maxThreads.
+// Every run checks that the items pushed equal the items popped plus those
+// left in the queue afterwards (count and sums): nothing lost or duplicated.
+//
+// Usage: ./multiQueueBenchmark [maxThreads] [opsPerThread]   (default 64 1000000)
+
+struct LockedQueue
+{
+    mutex lock;
+    priority_queue<pair<long long, int>> queue;
+
+    LockedQueue(unsigned) {}
+    void push(long long priority, int value)
+    {
+        lock_guard<mutex> guard(lock);
+        queue.push({priority, value});
+    }
+    bool tryPop(long long &priority, int &value)
+    {
+        lock_guard<mutex> guard(lock);
+        if (queue.empty())
+        {
+            return false;
+        }
+        priority = queue.top().first;
+        value = queue.top().second;
+        queue.pop();
+        return true;
+    }
+};
+
+template <unsigned C>
+struct RelaxedQueue : MultiQueue<long long, int>
+{
+    RelaxedQueue(unsigned threads) : MultiQueue<long long, int>(threads, C) {}
+};
+
+// Items a thread pushed or popped: count and the sums of their priorities
+// and values (wrapping), so a lost or duplicated item shows up.
+struct Tally
+{
+    size_t count = 0;
+    unsigned long long prioritySum = 0, valueSum = 0;
+
+    void add(long long priority, int value)
+    {
+        count++;
+        prioritySum += (unsigned long long)priority;
+        valueSum += (unsigned long long)value;
+    }
+    void add(const Tally &other)
+    {
+        count += other.count;
+        prioritySum += other.prioritySum;
+        valueSum += other.valueSum;
+    }
+    bool operator==(const Tally &other) const
+    {
+        return count == other.count && prioritySum == other.prioritySum && valueSum == other.valueSum;
+    }
+};
+
+// Returns operations per second; ok is cleared if the items pushed (prefill
+// included) differ from the items popped plus those drained after the join.
+template <typename Queue>
+double run(unsigned threads, size_t opsPerThread, bool &ok)
+{
+    Queue queue(threads);
+    mt19937_64 rng(3);
+    Tally pushed, popped;
+    for (int i = 0; i < 1000000; i++)
+    {
+        long long priority = (long long)(rng() >> 1);
+        queue.push(priority, i);
+        pushed.add(priority, i);
+    }
+
+    atomic<bool> go(false);
+    vector<Tally> pushedBy(threads), poppedBy(threads);
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            mt19937_64 local(t + 1);
+            Tally in, out;
+            long long priority;
+            int value;
+            while (!go.load())
+            {
+                this_thread::yield();
+            }
+            for (size_t i = 0; i < opsPerThread; i += 2)
+            {
+                priority = (long long)(local() >> 1);
+                queue.push(priority, (int)i);
+                in.add(priority, (int)i);
+                if (queue.tryPop(priority, value))
+                {
+                    out.add(priority, value);
+                }
+            }
+            pushedBy[t] = in;
+            poppedBy[t] = out; });
+    }
+    double seconds = timeIt([&]()
+                            {
+        go.store(true);
+        for (thread &worker : workers)
+        {
+            worker.join();
+        } });
+
+    for (unsigned t = 0; t < threads; t++)
+    {
+        pushed.add(pushedBy[t]);
+        popped.add(poppedBy[t]);
+    }
+    long long priority;
+    int value;
+    while (queue.tryPop(priority, value))
+    {
+        popped.add(priority, value);
+    }
+    ok = ok && pushed == popped;
+    return threads * opsPerThread / seconds;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned maxThreads = argc > 1 ? atoi(argv[1]) : 64;
+    size_t opsPerThread = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1000000;
+
+    bool ok = true;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        benchSection(to_string(threads) + " threads");
+        report("  mutex + std::priority_queue", {{run<LockedQueue>(threads, opsPerThread, ok) / 1e6, "Mops/s"}}, 32);
+        report("  MultiQueue c=2", {{run<RelaxedQueue<2>>(threads, opsPerThread, ok) / 1e6, "Mops/s"}}, 32);
+        report("  MultiQueue c=4", {{run<RelaxedQueue<4>>(threads, opsPerThread, ok) / 1e6, "Mops/s"}}, 32);
+    }
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <random>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "../sliding_quantile.h"
+#include "../t_digest.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Ingestion rate of the quantile trackers on log-normal "latency" samples:
+//   two unbounded priority_queues (the original MedianFinder scheme),
+//   SlidingQuantile over count windows of 1e3 and 1e5,
+//   TDigest on one thread and one TDigest per thread merged at the end,
+// followed by the t-digest error at p50/p99/p999 against an exact sort.
+// Checks: SlidingQuantile must equal the nearest-rank p99 of a sorted copy
+// of its window at a few points of the stream, and the t-digest's p50 / p99
+// must be within maxDigestError (relative) of the exact quantiles once there
+// are at least 10000 samples (below that the p99 tail is a handful of
+// samples and the digest's interpolation between them dominates).
+//
+// Usage: ./quantileBenchmark [samples] [maxThreads]   (default 10000000)
+
+const double maxDigestError = 0.02;
+
+void report(const string &label, size_t n, double seconds)
+{
+    report(label, {{seconds * 1e9 / n, "ns/op"}, {n / seconds / 1e6, "M/s", 1}}, 32);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    unsigned maxThreads = argc > 2 ? atoi(argv[2]) : thread::hardware_concurrency();
+    if (maxThreads == 0)
+    {
+        maxThreads = 1;
+    }
+
+    mt19937_64 rng(11);
+    lognormal_distribution<double> latency(0.0, 1.0);
+    vector<double> samples(n);
+    for (double &sample : samples)
+    {
+        sample = latency(rng);
+    }
+    double sink = 0;
+
+    double seconds = timeIt([&]()
+                            {
+        priority_queue<double> lower;
+        priority_queue<double, vector<double>, greater<double>> upper;
+        for (double x : samples)
+        {
+            if (lower.empty() || x <= lower.top())
+                lower.push(x);
+            else
+                upper.push(x);
+            if (lower.size() > upper.size() + 1)
+            {
+                upper.push(lower.top());
+                lower.pop();
+            }
+            else if (upper.size() > lower.size())
+            {
+                lower.push(upper.top());
+                upper.pop();
+            }
+        }
+        sink += lower.top(); });
+    report("two heaps (unbounded)", n, seconds);
+
+    for (size_t window : {(size_t)1000, (size_t)100000})
+    {
+        seconds = timeIt([&]()
+                         {
+            SlidingQuantile<double> p99(0.99, window);
+            for (double x : samples)
+            {
+                p99.add(x);
+            }
+            sink += p99.value(); });
+        report("SlidingQuantile p99 w=" + to_string(window), n, seconds);
+    }
+
+    // Untimed: the windowed p99 against the exact p99 of the same window.
+    bool ok = true;
+    for (size_t window : {(size_t)1000, (size_t)100000})
+    {
+        SlidingQuantile<double> p99(0.99, window);
+        vector<size_t> checkpoints = {window / 2, window, window + 1, n / 3, n / 2, n};
+        for (size_t i = 0; i < n; i++)
+        {
+            p99.add(samples[i]);
+            if (find(checkpoints.begin(), checkpoints.end(), i + 1) == checkpoints.end())
+            {
+                continue;
+            }
+            size_t count = min(i + 1, window);
+            vector<double> last(samples.begin() + (i + 1 - count), samples.begin() + (i + 1));
+            size_t rank = max<size_t>(1, min(count, (size_t)ceil(0.99 * count)));
+            nth_element(last.begin(), last.begin() + (rank - 1), last.end());
+            ok = ok && p99.value() == last[rank - 1];
+        }
+    }
+
+    TDigest single;
+    seconds = timeIt([&]()
+                     {
+        for (double x : samples)
+        {
+            single.add(x);
+        }
+        sink += single.quantile(0.99); });
+    report("TDigest", n, seconds);
+
+    for (unsigned threads = 2; threads <= maxThreads; threads *= 2)
+    {
+        seconds = timeIt([&]()
+                         {
+            vector<TDigest> digests(threads);
+            vector<thread> workers;
+            for (unsigned t = 0; t < threads; t++)
+            {
+                workers.emplace_back([&, t]()
+                                     {
+                    for (size_t i = n * t / threads; i < n * (t + 1) / threads; i++)
+                    {
+                        digests[t].add(samples[i]);
+                    } });
+            }
+            for (thread &worker : workers)
+            {
+                worker.join();
+            }
+            for (unsigned t = 1; t < threads; t++)
+            {
+                digests[0].merge(digests[t]);
+            }
+            sink += digests[0].quantile(0.99); });
+        report("TDigest x" + to_string(threads) + " merged", n, seconds);
+    }
+
+    sort(samples.begin(), samples.end());
+    cout << endl;
+    benchSection("TDigest accuracy", to_string(single.centroidCount()) + " centroids, " +
+                                         to_string(single.memoryBytes() / 1024) + " KiB");
+    const double qs[] = {0.5, 0.99, 0.999};
+    const char *names[] = {"p50", "p99", "p999"};
+    for (int i = 0; i < 3; i++)
+    {
+        double q = qs[i];
+        double exact = samples[min(n - 1, (size_t)(q * n))];
+        double estimate = single.quantile(q);
+        double error = abs(estimate - exact) / exact;
+        report(string("  ") + names[i], {{exact, "exact", 4}, {estimate, "estimate", 4}, {100 * error, "error %", 3}}, 8);
+        if (q < 0.999 && n >= 10000)
+        {
+            ok = ok && error <= maxDigestError;
+        }
+    }
+    cout << "(checksum " << sink << ")" << endl;
+    cout << "checks: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
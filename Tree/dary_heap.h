@@ -0,0 +1,272 @@
+#ifndef DARY_HEAP_H
+#define DARY_HEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// D-ary heap stored in a flat vector.
+//
+// Compare follows std::priority_queue: with std::less the largest element is
+// on top (max-heap), with std::greater the smallest one is. The children of
+// node i are the Arity consecutive slots starting at Arity * i + 1, so with
+// Arity = 4 or 8 and small payloads every sibling group sits in one cache line
+// and the tree is half / a third as deep as a binary heap.
+//
+// Both sifts are iterative and use a "hole": the moving element is lifted out
+// once, the elements on its path are shifted into the hole, and it is written
+// back a single time at the end instead of being swapped at every level.
+template <typename T, std::size_t Arity = 4, typename Compare = std::less<T>>
+class DaryHeap
+{
+    static_assert(Arity >= 2, "DaryHeap needs at least two children per node");
+
+private:
+    std::vector<T> heap;
+    Compare comp;
+
+    static std::size_t parentOf(std::size_t index) { return (index - 1) / Arity; }
+    static std::size_t firstChildOf(std::size_t index) { return Arity * index + 1; }
+
+    // comp(a, b) means "a has lower priority than b".
+    void siftUp(std::size_t index)
+    {
+        T value = std::move(heap[index]);
+        while (index > 0)
+        {
+            std::size_t parent = parentOf(index);
+            if (!comp(heap[parent], value))
+            {
+                break;
+            }
+            heap[index] = std::move(heap[parent]);
+            index = parent;
+        }
+        heap[index] = std::move(value);
+    }
+
+    void siftDown(std::size_t index)
+    {
+        const std::size_t n = heap.size();
+        T value = std::move(heap[index]);
+        while (true)
+        {
+            std::size_t first = firstChildOf(index);
+            if (first >= n)
+            {
+                break;
+            }
+            std::size_t last = first + Arity < n ? first + Arity : n;
+            std::size_t best = first;
+            for (std::size_t child = first + 1; child < last; ++child)
+            {
+                if (comp(heap[best], heap[child]))
+                {
+                    best = child;
+                }
+            }
+            if (!comp(value, heap[best]))
+            {
+                break;
+            }
+            heap[index] = std::move(heap[best]);
+            index = best;
+        }
+        heap[index] = std::move(value);
+    }
+
+    // Removes the root. The vacated root slot is walked down to a leaf by
+    // promoting the best child at each level (one comparison group per level,
+    // no comparison against the displaced element), then the last element is
+    // dropped into that leaf and sifted up; it almost always stays near the
+    // bottom, so this does fewer comparisons than a plain sift-down.
+    void removeTop()
+    {
+        const std::size_t n = heap.size() - 1;
+        if (n == 0)
+        {
+            heap.pop_back();
+            return;
+        }
+        std::size_t index = 0;
+        while (true)
+        {
+            std::size_t first = firstChildOf(index);
+            if (first >= n)
+            {
+                break;
+            }
+            std::size_t last = first + Arity < n ? first + Arity : n;
+            std::size_t best = first;
+            for (std::size_t child = first + 1; child < last; ++child)
+            {
+                if (comp(heap[best], heap[child]))
+                {
+                    best = child;
+                }
+            }
+            heap[index] = std::move(heap[best]);
+            index = best;
+        }
+        if (index != n)
+        {
+            heap[index] = std::move(heap[n]);
+            heap.pop_back();
+            siftUp(index);
+        }
+        else
+        {
+            heap.pop_back();
+        }
+    }
+
+    // Floyd's bottom-up construction over the whole array, O(n).
+    void heapifyAll()
+    {
+        if (heap.size() < 2)
+        {
+            return;
+        }
+        for (std::size_t i = parentOf(heap.size() - 1) + 1; i-- > 0;)
+        {
+            siftDown(i);
+        }
+    }
+
+public:
+    DaryHeap() = default;
+    explicit DaryHeap(const Compare &compare) : comp(compare) {}
+
+    void push(const T &value)
+    {
+        heap.push_back(value);
+        siftUp(heap.size() - 1);
+    }
+
+    void push(T &&value)
+    {
+        heap.push_back(std::move(value));
+        siftUp(heap.size() - 1);
+    }
+
+    template <typename... Args>
+    void emplace(Args &&...args)
+    {
+        heap.emplace_back(std::forward<Args>(args)...);
+        siftUp(heap.size() - 1);
+    }
+
+    const T &top() const
+    {
+        if (heap.empty())
+        {
+            throw std::out_of_range("DaryHeap::top on empty heap");
+        }
+        return heap.front();
+    }
+
+    void pop()
+    {
+        if (heap.empty())
+        {
+            throw std::out_of_range("DaryHeap::pop on empty heap");
+        }
+        removeTop();
+    }
+
+    // Removes and returns the top element.
+    T extractTop()
+    {
+        if (heap.empty())
+        {
+            throw std::out_of_range("DaryHeap::extractTop on empty heap");
+        }
+        T result = std::move(heap.front());
+        removeTop();
+        return result;
+    }
+
+    // Pops the top and pushes value in one sift-down (bounded top-K heaps).
+    void replaceTop(T value)
+    {
+        if (heap.empty())
+        {
+            throw std::out_of_range("DaryHeap::replaceTop on empty heap");
+        }
+        heap.front() = std::move(value);
+        siftDown(0);
+    }
+
+    // Appends a whole range. When the batch is large compared to the heap it
+    // is cheaper to re-run Floyd's O(n + k) construction than to sift every new
+    // element up on its own (O(k log n)), so the cheaper path is picked here.
+    template <typename InputIt>
+    void insertBatch(InputIt first, InputIt last)
+    {
+        std::size_t oldSize = heap.size();
+        heap.insert(heap.end(), first, last);
+        std::size_t added = heap.size() - oldSize;
+        if (added == 0)
+        {
+            return;
+        }
+
+        std::size_t depth = 1;
+        for (std::size_t span = heap.size(); span > Arity; span /= Arity)
+        {
+            ++depth;
+        }
+        if (added * depth > heap.size())
+        {
+            heapifyAll();
+        }
+        else
+        {
+            for (std::size_t i = oldSize; i < heap.size(); ++i)
+            {
+                siftUp(i);
+            }
+        }
+    }
+
+    void insertBatch(const std::vector<T> &values)
+    {
+        insertBatch(values.begin(), values.end());
+    }
+
+    // Pops up to k elements and returns them in priority order.
+    std::vector<T> extractTopK(std::size_t k)
+    {
+        std::vector<T> result;
+        if (k > heap.size())
+        {
+            k = heap.size();
+        }
+        result.reserve(k);
+        for (std::size_t i = 0; i < k; ++i)
+        {
+            result.push_back(std::move(heap.front()));
+            removeTop();
+        }
+        return result;
+    }
+
+    // Replaces the contents with values and heapifies them in O(n).
+    void buildHeap(std::vector<T> values)
+    {
+        heap = std::move(values);
+        heapifyAll();
+    }
+
+    void reserve(std::size_t capacity) { heap.reserve(capacity); }
+    void clear() { heap.clear(); }
+    std::size_t size() const { return heap.size(); }
+    bool empty() const { return heap.empty(); }
+
+    // Underlying array in heap order (for display and debugging).
+    const std::vector<T> &data() const { return heap; }
+};
+
+#endif // DARY_HEAP_H
@@ -0,0 +1,252 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Addressable d-ary heap over a fixed universe of ids [0, capacity).
+//
+// Every id (for graph code: a vertex number) is its own handle. Next to the
+// heap array of ids the structure keeps the key of each id and the slot the
+// id currently occupies, so the priority of an element that is already in the
+// heap can be changed or the element erased in O(log n) instead of pushing a
+// duplicate and skipping the stale copy when it is popped.
+//
+// Compare follows std::priority_queue and DaryHeap: std::less puts the largest
+// key on top, std::greater the smallest (what Dijkstra and Prim want).
+template <typename Key, std::size_t Arity = 4, typename Compare = std::less<Key>>
+class IndexedHeap
+{
+    static_assert(Arity >= 2, "IndexedHeap needs at least two children per node");
+
+public:
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+    std::vector<std::size_t> heap; // heap slot -> id
+    std::vector<std::size_t> pos;  // id -> heap slot, npos when absent
+    std::vector<Key> keys;         // id -> key
+    Compare comp;
+
+    static std::size_t parentOf(std::size_t index) { return (index - 1) / Arity; }
+    static std::size_t firstChildOf(std::size_t index) { return Arity * index + 1; }
+
+    bool lower(std::size_t idA, std::size_t idB) const
+    {
+        return comp(keys[idA], keys[idB]);
+    }
+
+    void place(std::size_t index, std::size_t id)
+    {
+        heap[index] = id;
+        pos[id] = index;
+    }
+
+    void siftUp(std::size_t index)
+    {
+        std::size_t id = heap[index];
+        while (index > 0)
+        {
+            std::size_t parent = parentOf(index);
+            if (!lower(heap[parent], id))
+            {
+                break;
+            }
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, id);
+    }
+
+    void siftDown(std::size_t index)
+    {
+        const std::size_t n = heap.size();
+        std::size_t id = heap[index];
+        while (true)
+        {
+            std::size_t first = firstChildOf(index);
+            if (first >= n)
+            {
+                break;
+            }
+            std::size_t last = first + Arity < n ? first + Arity : n;
+            std::size_t best = first;
+            for (std::size_t child = first + 1; child < last; ++child)
+            {
+                if (lower(heap[best], heap[child]))
+                {
+                    best = child;
+                }
+            }
+            if (!lower(id, heap[best]))
+            {
+                break;
+            }
+            place(index, heap[best]);
+            index = best;
+        }
+        place(index, id);
+    }
+
+    void checkId(std::size_t id) const
+    {
+        if (id >= pos.size())
+        {
+            throw std::out_of_range("IndexedHeap: id out of range");
+        }
+    }
+
+    void checkPresent(std::size_t id) const
+    {
+        checkId(id);
+        if (pos[id] == npos)
+        {
+            throw std::invalid_argument("IndexedHeap: id is not in the heap");
+        }
+    }
+
+public:
+    explicit IndexedHeap(std::size_t capacity = 0, const Compare &compare = Compare())
+        : pos(capacity, npos), keys(capacity), comp(compare)
+    {
+        heap.reserve(capacity);
+    }
+
+    std::size_t capacity() const { return pos.size(); }
+    std::size_t size() const { return heap.size(); }
+    bool empty() const { return heap.empty(); }
+
+    bool contains(std::size_t id) const
+    {
+        return id < pos.size() && pos[id] != npos;
+    }
+
+    const Key &keyOf(std::size_t id) const
+    {
+        checkPresent(id);
+        return keys[id];
+    }
+
+    void push(std::size_t id, const Key &key)
+    {
+        checkId(id);
+        if (pos[id] != npos)
+        {
+            throw std::invalid_argument("IndexedHeap: id is already in the heap");
+        }
+        keys[id] = key;
+        heap.push_back(id);
+        pos[id] = heap.size() - 1;
+        siftUp(heap.size() - 1);
+    }
+
+    // Inserts the id or, when it is already present, replaces its key.
+    void pushOrUpdate(std::size_t id, const Key &key)
+    {
+        if (contains(id))
+        {
+            changeKey(id, key);
+        }
+        else
+        {
+            push(id, key);
+        }
+    }
+
+    std::size_t topId() const
+    {
+        if (heap.empty())
+        {
+            throw std::out_of_range("IndexedHeap::topId on empty heap");
+        }
+        return heap.front();
+    }
+
+    const Key &topKey() const
+    {
+        return keys[topId()];
+    }
+
+    // Removes the top element and returns its id.
+    std::size_t pop()
+    {
+        std::size_t id = topId();
+        erase(id);
+        return id;
+    }
+
+    // Sets a new key and moves the element in whichever direction it needs.
+    void changeKey(std::size_t id, const Key &key)
+    {
+        checkPresent(id);
+        bool raised = comp(keys[id], key);
+        keys[id] = key;
+        if (raised)
+        {
+            siftUp(pos[id]);
+        }
+        else
+        {
+            siftDown(pos[id]);
+        }
+    }
+
+    // Graph-algorithm spelling of changeKey: the new key is smaller than the
+    // current one. In a min-heap (std::greater) this moves the element up.
+    void decreaseKey(std::size_t id, const Key &key)
+    {
+        changeKey(id, key);
+    }
+
+    // The new key is larger than the current one.
+    void increaseKey(std::size_t id, const Key &key)
+    {
+        changeKey(id, key);
+    }
+
+    void erase(std::size_t id)
+    {
+        checkPresent(id);
+        std::size_t index = pos[id];
+        std::size_t lastId = heap.back();
+        heap.pop_back();
+        pos[id] = npos;
+        if (lastId == id)
+        {
+            return;
+        }
+        place(index, lastId);
+        if (index > 0 && lower(heap[parentOf(index)], lastId))
+        {
+            siftUp(index);
+        }
+        else
+        {
+            siftDown(index);
+        }
+    }
+
+    void clear()
+    {
+        for (std::size_t id : heap)
+        {
+            pos[id] = npos;
+        }
+        heap.clear();
+    }
+
+    // Bytes held by the three arrays, for memory comparisons.
+    std::size_t memoryBytes() const
+    {
+        return heap.capacity() * sizeof(std::size_t) + pos.capacity() * sizeof(std::size_t) +
+               keys.capacity() * sizeof(Key);
+    }
+};
+
+template <typename Key, std::size_t Arity, typename Compare>
+const std::size_t IndexedHeap<Key, Arity, Compare>::npos;
+
+#endif // INDEXED_HEAP_H
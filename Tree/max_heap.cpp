@@ -1,48 +1,27 @@
 #include <iostream>
 #include <vector>
+#include "dary_heap.h"
 
 using namespace std;
 
+// Max-heap of ints backed by the 4-ary DaryHeap engine (see dary_heap.h):
+// iterative hole sifts instead of recursive swap-based heapify, and shallower
+// trees whose sibling groups share a cache line.
 class MaxHeap
 {
 private:
-    vector<int> heap;
-    void heapify(int index)
-    {
-        int largest = index;
-        int left = 2 * index + 1;
-        int right = 2 * index + 2;
-
-        if (left < heap.size() && heap[left] > heap[largest])
-        {
-            largest = left;
-        }
-
-        if (right < heap.size() && heap[right] > heap[largest])
-        {
-            largest = right;
-        }
+    DaryHeap<int, 4> heap;
 
-        if (largest != index)
-        {
-            swap(heap[index], heap[largest]);
-            heapify(largest);
-        }
-    }
-    void bubbleUp(int index)
+public:
+    void insert(int value)
     {
-        while (index > 0 && heap[(index - 1) / 2] < heap[index])
-        {
-            swap(heap[index], heap[(index - 1) / 2]);
-            index = (index - 1) / 2;
-        }
+        heap.push(value);
     }
 
-public:
-    void insert(int value)
+    // Inserts all values at once; large batches are heapified in O(n + k).
+    void insertBatch(const vector<int> &values)
     {
-        heap.push_back(value);
-        bubbleUp(heap.size() - 1);
+        heap.insertBatch(values);
     }
 
     int extractMax()
@@ -52,11 +31,13 @@ public:
             cout << "Heap is empty" << endl;
             return -1;
         }
-        int maxVal = heap[0];
-        heap[0] = heap.back();
-        heap.pop_back();
-        heapify(0);
-        return maxVal;
+        return heap.extractTop();
+    }
+
+    // Removes the k largest values and returns them in descending order.
+    vector<int> extractTopK(int k)
+    {
+        return heap.extractTopK(k < 0 ? 0 : k);
     }
 
     int peek()
@@ -66,17 +47,12 @@ public:
             cout << "Heap is empty.";
             return -1;
         }
-        return heap[0];
+        return heap.top();
     }
 
     void buildHeap(const vector<int> &arr)
     {
-        heap = arr;
-
-        for (int i = heap.size() / 2 - 1; i >= 0; --i)
-        {
-            heapify(i);
-        }
+        heap.buildHeap(arr);
     }
 
     int size()
@@ -91,7 +67,7 @@ public:
 
     void display()
     {
-        for (int val : heap)
+        for (int val : heap.data())
         {
             cout << val << " ";
         }
@@ -122,6 +98,14 @@ int main()
 
     cout << "Size of heap: " << maxHeap.size() << endl;
 
+    maxHeap.insertBatch({7, 45, 12, 33});
+    cout << "Top 3 after batch insert: ";
+    for (int val : maxHeap.extractTopK(3))
+    {
+        cout << val << " ";
+    }
+    cout << endl;
+
     cout << "Is heap empty? " << (maxHeap.empty() ? "Yes" : "No") << endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,200 @@
+#ifndef MULTI_QUEUE_H
+#define MULTI_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "dary_heap.h"
+
+// Relaxed concurrent priority queue (MultiQueue, Rihani/Sanders/Dementiev).
+//
+// The queue is c * threads independent DaryHeaps ("shards"), each behind its
+// own try-lock and on its own cache line. push() puts the item into a random
+// shard; tryPop() samples `choices` random shards, reads their cached top
+// priorities without locking and pops from the best one. Nobody ever waits on
+// a lock: a busy shard is simply skipped and another one sampled.
+//
+// The price is relaxation: a pop returns one of the highest-priority items,
+// not necessarily the highest (expected rank error O(c * threads)). More
+// shards per thread reduce contention, more choices improve the quality.
+//
+// Priority must be trivially copyable (it is cached in a std::atomic);
+// Compare follows std::priority_queue, so std::less pops large priorities
+// first. Shards are cache-line aligned, which needs C++17 aligned new.
+template <typename Priority, typename Value, typename Compare = std::less<Priority>>
+class MultiQueue
+{
+    static_assert(std::is_trivially_copyable<Priority>::value,
+                  "MultiQueue caches priorities in std::atomic");
+
+private:
+    struct Entry
+    {
+        Priority priority;
+        Value value;
+    };
+
+    struct EntryCompare
+    {
+        Compare comp;
+        bool operator()(const Entry &a, const Entry &b) const { return comp(a.priority, b.priority); }
+    };
+
+    struct alignas(64) Shard
+    {
+        std::atomic_flag locked = ATOMIC_FLAG_INIT;
+        std::atomic<std::size_t> size{0};
+        std::atomic<Priority> top{Priority()};
+        DaryHeap<Entry, 4, EntryCompare> heap;
+
+        bool tryLock() { return !locked.test_and_set(std::memory_order_acquire); }
+        void unlock() { locked.clear(std::memory_order_release); }
+
+        // Called with the lock held after every change.
+        void publish()
+        {
+            if (!heap.empty())
+            {
+                top.store(heap.top().priority, std::memory_order_relaxed);
+            }
+            size.store(heap.size(), std::memory_order_release);
+        }
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    std::size_t shardCount;
+    unsigned choices;
+    Compare comp;
+
+    static std::uint64_t nextRandom()
+    {
+        static thread_local std::uint64_t state =
+            0x9E3779B97F4A7C15ull ^ reinterpret_cast<std::uintptr_t>(&state);
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    std::size_t randomShard() { return nextRandom() % shardCount; }
+
+    bool popLocked(Shard &shard, Priority &priority, Value &value)
+    {
+        if (shard.heap.empty())
+        {
+            return false;
+        }
+        Entry entry = shard.heap.extractTop();
+        shard.publish();
+        priority = entry.priority;
+        value = std::move(entry.value);
+        return true;
+    }
+
+public:
+    // threads: expected number of concurrent users; queuesPerThread is the
+    // relaxation factor c (c >= 2 keeps contention low).
+    explicit MultiQueue(unsigned threads, unsigned queuesPerThread = 2, unsigned choices = 2,
+                        const Compare &compare = Compare())
+        : shardCount((std::size_t)(threads ? threads : 1) * (queuesPerThread ? queuesPerThread : 1)),
+          choices(choices ? choices : 1), comp(compare)
+    {
+        shards.reset(new Shard[shardCount]);
+        for (std::size_t i = 0; i < shardCount; ++i)
+        {
+            shards[i].heap = DaryHeap<Entry, 4, EntryCompare>(EntryCompare{compare});
+        }
+    }
+
+    void push(const Priority &priority, Value value)
+    {
+        while (true)
+        {
+            Shard &shard = shards[randomShard()];
+            if (!shard.tryLock())
+            {
+                continue;
+            }
+            shard.heap.push(Entry{priority, std::move(value)});
+            shard.publish();
+            shard.unlock();
+            return;
+        }
+    }
+
+    // Pops a high-priority item. Returns false only if every shard was seen
+    // empty during a full sweep (the queue may be refilled concurrently).
+    bool tryPop(Priority &priority, Value &value)
+    {
+        for (std::size_t attempt = 0; attempt < 4 * shardCount; ++attempt)
+        {
+            Shard *best = nullptr;
+            Priority bestPriority = Priority();
+            for (unsigned c = 0; c < choices; ++c)
+            {
+                Shard &candidate = shards[randomShard()];
+                if (candidate.size.load(std::memory_order_acquire) == 0)
+                {
+                    continue;
+                }
+                Priority candidateTop = candidate.top.load(std::memory_order_relaxed);
+                if (best == nullptr || comp(bestPriority, candidateTop))
+                {
+                    best = &candidate;
+                    bestPriority = candidateTop;
+                }
+            }
+            if (best == nullptr || !best->tryLock())
+            {
+                continue;
+            }
+            bool popped = popLocked(*best, priority, value);
+            best->unlock();
+            if (popped)
+            {
+                return true;
+            }
+        }
+
+        // Sampling kept missing: sweep every shard once before giving up.
+        for (std::size_t i = 0; i < shardCount; ++i)
+        {
+            Shard &shard = shards[i];
+            if (shard.size.load(std::memory_order_acquire) == 0)
+            {
+                continue;
+            }
+            while (!shard.tryLock())
+            {
+                std::this_thread::yield();
+            }
+            bool popped = popLocked(shard, priority, value);
+            shard.unlock();
+            if (popped)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Sum of shard sizes; exact only when no other thread is active.
+    std::size_t sizeApprox() const
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < shardCount; ++i)
+        {
+            total += shards[i].size.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    std::size_t queueCount() const { return shardCount; }
+};
+
+#endif // MULTI_QUEUE_H
@@ -0,0 +1,252 @@
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Addressable pairing heap over a fixed universe of ids [0, capacity).
+//
+// Same interface and Compare convention as IndexedHeap (indexed_heap.h) so the
+// two can be swapped in graph code. Nodes live in one vector indexed by id, so
+// there is no allocation per push. Raising a priority is O(1) (cut the subtree
+// and meld it with the root); pop and erase use the standard two-pass pairing,
+// amortized O(log n).
+template <typename Key, typename Compare = std::less<Key>>
+class PairingHeap
+{
+public:
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+    struct Node
+    {
+        Key key;
+        std::size_t child = npos;
+        std::size_t next = npos; // right sibling
+        std::size_t prev = npos; // left sibling, or parent for a leftmost child
+        bool inHeap = false;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::size_t> scratch; // reused by mergePairs
+    std::size_t root = npos;
+    std::size_t count = 0;
+    Compare comp;
+
+    // Melds two detached roots and returns the winner.
+    std::size_t link(std::size_t a, std::size_t b)
+    {
+        if (comp(nodes[a].key, nodes[b].key))
+        {
+            std::swap(a, b);
+        }
+        std::size_t oldChild = nodes[a].child;
+        nodes[b].next = oldChild;
+        if (oldChild != npos)
+        {
+            nodes[oldChild].prev = b;
+        }
+        nodes[b].prev = a;
+        nodes[a].child = b;
+        return a;
+    }
+
+    // Detaches a non-root node (with its subtree) from its parent.
+    void cut(std::size_t id)
+    {
+        Node &node = nodes[id];
+        if (nodes[node.prev].child == id)
+        {
+            nodes[node.prev].child = node.next;
+        }
+        else
+        {
+            nodes[node.prev].next = node.next;
+        }
+        if (node.next != npos)
+        {
+            nodes[node.next].prev = node.prev;
+        }
+        node.next = npos;
+        node.prev = npos;
+    }
+
+    // Two-pass pairing of a sibling list; returns the new subtree root.
+    std::size_t mergePairs(std::size_t first)
+    {
+        scratch.clear();
+        std::size_t current = first;
+        while (current != npos)
+        {
+            std::size_t a = current;
+            std::size_t b = nodes[a].next;
+            nodes[a].next = nodes[a].prev = npos;
+            if (b == npos)
+            {
+                scratch.push_back(a);
+                break;
+            }
+            current = nodes[b].next;
+            nodes[b].next = nodes[b].prev = npos;
+            scratch.push_back(link(a, b));
+        }
+        if (scratch.empty())
+        {
+            return npos;
+        }
+        std::size_t result = scratch.back();
+        for (std::size_t i = scratch.size() - 1; i > 0; --i)
+        {
+            result = link(scratch[i - 1], result);
+        }
+        return result;
+    }
+
+    void checkId(std::size_t id) const
+    {
+        if (id >= nodes.size())
+        {
+            throw std::out_of_range("PairingHeap: id out of range");
+        }
+    }
+
+    void checkPresent(std::size_t id) const
+    {
+        checkId(id);
+        if (!nodes[id].inHeap)
+        {
+            throw std::invalid_argument("PairingHeap: id is not in the heap");
+        }
+    }
+
+public:
+    explicit PairingHeap(std::size_t capacity = 0, const Compare &compare = Compare())
+        : nodes(capacity), comp(compare) {}
+
+    std::size_t capacity() const { return nodes.size(); }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    bool contains(std::size_t id) const
+    {
+        return id < nodes.size() && nodes[id].inHeap;
+    }
+
+    const Key &keyOf(std::size_t id) const
+    {
+        checkPresent(id);
+        return nodes[id].key;
+    }
+
+    void push(std::size_t id, const Key &key)
+    {
+        checkId(id);
+        if (nodes[id].inHeap)
+        {
+            throw std::invalid_argument("PairingHeap: id is already in the heap");
+        }
+        Node &node = nodes[id];
+        node.key = key;
+        node.child = node.next = node.prev = npos;
+        node.inHeap = true;
+        root = root == npos ? id : link(root, id);
+        ++count;
+    }
+
+    void pushOrUpdate(std::size_t id, const Key &key)
+    {
+        if (contains(id))
+        {
+            changeKey(id, key);
+        }
+        else
+        {
+            push(id, key);
+        }
+    }
+
+    std::size_t topId() const
+    {
+        if (root == npos)
+        {
+            throw std::out_of_range("PairingHeap::topId on empty heap");
+        }
+        return root;
+    }
+
+    const Key &topKey() const
+    {
+        return nodes[topId()].key;
+    }
+
+    std::size_t pop()
+    {
+        std::size_t id = topId();
+        root = mergePairs(nodes[id].child);
+        nodes[id].child = npos;
+        nodes[id].inHeap = false;
+        --count;
+        return id;
+    }
+
+    void changeKey(std::size_t id, const Key &key)
+    {
+        checkPresent(id);
+        if (comp(nodes[id].key, key))
+        {
+            nodes[id].key = key;
+            if (id != root)
+            {
+                cut(id);
+                root = link(root, id);
+            }
+        }
+        else
+        {
+            erase(id);
+            push(id, key);
+        }
+    }
+
+    void decreaseKey(std::size_t id, const Key &key)
+    {
+        changeKey(id, key);
+    }
+
+    void increaseKey(std::size_t id, const Key &key)
+    {
+        changeKey(id, key);
+    }
+
+    void erase(std::size_t id)
+    {
+        checkPresent(id);
+        if (id == root)
+        {
+            pop();
+            return;
+        }
+        cut(id);
+        std::size_t subtree = mergePairs(nodes[id].child);
+        nodes[id].child = npos;
+        nodes[id].inHeap = false;
+        --count;
+        if (subtree != npos)
+        {
+            root = link(root, subtree);
+        }
+    }
+
+    std::size_t memoryBytes() const
+    {
+        return nodes.capacity() * sizeof(Node) + scratch.capacity() * sizeof(std::size_t);
+    }
+};
+
+template <typename Key, typename Compare>
+const std::size_t PairingHeap<Key, Compare>::npos;
+
+#endif // PAIRING_HEAP_H
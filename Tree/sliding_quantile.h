@@ -0,0 +1,154 @@
+#ifndef SLIDING_QUANTILE_H
+#define SLIDING_QUANTILE_H
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+#include "indexed_heap.h"
+
+// Exact quantile over a sliding window of the most recent samples.
+//
+// This is the two-heap MedianFinder generalized in two ways:
+//   * the split point is any quantile p, not only the median: the lower
+//     (max-)heap holds the ceil(p * count) smallest samples, so its top is the
+//     nearest-rank p-quantile;
+//   * samples expire. Every sample gets the slot (arrival number % maxCount)
+//     as its id in an IndexedHeap, so the oldest one can be erased from
+//     whichever heap holds it in O(log n). A window is bounded by count, and
+//     optionally by age: add(value, now) and expire(now) drop every sample
+//     whose timestamp is <= now - maxAge (timestamps in any caller unit).
+template <typename T = double>
+class SlidingQuantile
+{
+private:
+    double p;
+    std::size_t maxCount;
+    long long maxAge;
+
+    IndexedHeap<T, 4, std::less<T>> low;     // smallest ceil(p * count), max on top
+    IndexedHeap<T, 4, std::greater<T>> high; // the rest, min on top
+    std::vector<long long> stamps;           // slot -> arrival timestamp
+    unsigned long long oldest = 0;           // arrival number of the oldest live sample
+    unsigned long long next = 0;             // arrival number of the next sample
+
+    std::size_t targetLow() const
+    {
+        std::size_t count = low.size() + high.size();
+        if (count == 0)
+        {
+            return 0;
+        }
+        std::size_t rank = (std::size_t)std::ceil(p * count);
+        return rank < 1 ? 1 : (rank > count ? count : rank);
+    }
+
+    void rebalance()
+    {
+        std::size_t target = targetLow();
+        while (low.size() > target)
+        {
+            T key = low.topKey();
+            high.push(low.pop(), key);
+        }
+        while (low.size() < target)
+        {
+            T key = high.topKey();
+            low.push(high.pop(), key);
+        }
+    }
+
+    void removeOldest()
+    {
+        std::size_t slot = oldest % maxCount;
+        if (low.contains(slot))
+        {
+            low.erase(slot);
+        }
+        else
+        {
+            high.erase(slot);
+        }
+        ++oldest;
+    }
+
+public:
+    // maxAge == 0 means the window is bounded by count only.
+    SlidingQuantile(double p, std::size_t maxCount, long long maxAge = 0)
+        : p(p), maxCount(maxCount), maxAge(maxAge), low(maxCount), high(maxCount), stamps(maxCount)
+    {
+        if (p < 0 || p > 1 || maxCount == 0)
+        {
+            throw std::invalid_argument("SlidingQuantile: need 0 <= p <= 1 and maxCount > 0");
+        }
+    }
+
+    void add(const T &value, long long now = 0)
+    {
+        expire(now);
+        if (size() == maxCount)
+        {
+            removeOldest();
+        }
+        std::size_t slot = next % maxCount;
+        stamps[slot] = now;
+        ++next;
+        if (!low.empty() && !(low.topKey() < value))
+        {
+            low.push(slot, value);
+        }
+        else
+        {
+            high.push(slot, value);
+        }
+        rebalance();
+    }
+
+    // Drops samples that are too old; only meaningful with maxAge > 0.
+    void expire(long long now)
+    {
+        if (maxAge <= 0)
+        {
+            return;
+        }
+        bool removed = false;
+        while (oldest < next && stamps[oldest % maxCount] <= now - maxAge)
+        {
+            removeOldest();
+            removed = true;
+        }
+        if (removed)
+        {
+            rebalance();
+        }
+    }
+
+    std::size_t size() const { return (std::size_t)(next - oldest); }
+    bool empty() const { return next == oldest; }
+
+    // Nearest-rank p-quantile of the window.
+    const T &value() const
+    {
+        if (low.empty())
+        {
+            throw std::out_of_range("SlidingQuantile::value on empty window");
+        }
+        return low.topKey();
+    }
+
+    // The order statistic right after value(); the median of an even-sized
+    // window is the mean of value() and upperValue().
+    const T &upperValue() const
+    {
+        if (high.empty())
+        {
+            throw std::out_of_range("SlidingQuantile::upperValue with no larger sample");
+        }
+        return high.topKey();
+    }
+
+    bool hasUpperValue() const { return !high.empty(); }
+};
+
+#endif // SLIDING_QUANTILE_H
@@ -0,0 +1,178 @@
+#ifndef T_DIGEST_H
+#define T_DIGEST_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// Merging t-digest (Dunning & Ertl): an approximate quantile sketch with
+// bounded memory. Samples are appended to a small buffer; when it fills up,
+// buffer and centroids are sorted by mean and greedily merged so that each
+// centroid covers at most one unit of the k1 scale function
+//     k(q) = compression / (2 pi) * asin(2q - 1),
+// which keeps centroids tiny near q = 0 and q = 1. That is why p99 / p999
+// stay accurate while the digest holds only O(compression) centroids.
+//
+// Digests built independently (one per thread) are combined with merge().
+class TDigest
+{
+private:
+    static constexpr double kPi = 3.14159265358979323846;
+
+    struct Centroid
+    {
+        double mean;
+        double weight;
+        bool operator<(const Centroid &other) const { return mean < other.mean; }
+    };
+
+    double compression;
+    std::vector<Centroid> centroids;
+    std::vector<Centroid> buffer;
+    std::size_t bufferLimit;
+    double totalWeight = 0;
+    double minValue = std::numeric_limits<double>::infinity();
+    double maxValue = -std::numeric_limits<double>::infinity();
+
+    double scale(double q) const
+    {
+        return compression / (2 * kPi) * std::asin(2 * q - 1);
+    }
+
+    double inverseScale(double k) const
+    {
+        if (k >= compression / 4)
+        {
+            return 1;
+        }
+        return (std::sin(k * 2 * kPi / compression) + 1) / 2;
+    }
+
+    void compress()
+    {
+        if (buffer.empty())
+        {
+            return;
+        }
+        buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+        std::sort(buffer.begin(), buffer.end());
+        centroids.clear();
+
+        double soFar = 0;
+        double limit = totalWeight * inverseScale(scale(0) + 1);
+        Centroid current = buffer[0];
+        for (std::size_t i = 1; i < buffer.size(); ++i)
+        {
+            const Centroid &next = buffer[i];
+            if (soFar + current.weight + next.weight <= limit)
+            {
+                current.weight += next.weight;
+                current.mean += (next.mean - current.mean) * next.weight / current.weight;
+            }
+            else
+            {
+                soFar += current.weight;
+                centroids.push_back(current);
+                limit = totalWeight * inverseScale(scale(soFar / totalWeight) + 1);
+                current = next;
+            }
+        }
+        centroids.push_back(current);
+        buffer.clear();
+    }
+
+public:
+    explicit TDigest(double compression = 200)
+        : compression(compression), bufferLimit((std::size_t)(compression * 16))
+    {
+        buffer.reserve(bufferLimit + (std::size_t)compression);
+    }
+
+    void add(double value, double weight = 1)
+    {
+        buffer.push_back(Centroid{value, weight});
+        totalWeight += weight;
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+        if (buffer.size() >= bufferLimit)
+        {
+            compress();
+        }
+    }
+
+    void merge(const TDigest &other)
+    {
+        for (const Centroid &c : other.centroids)
+        {
+            buffer.push_back(c);
+        }
+        for (const Centroid &c : other.buffer)
+        {
+            buffer.push_back(c);
+        }
+        totalWeight += other.totalWeight;
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+        compress();
+    }
+
+    double count() const { return totalWeight; }
+
+    std::size_t centroidCount()
+    {
+        compress();
+        return centroids.size();
+    }
+
+    // Estimated q-quantile, 0 <= q <= 1. Interpolates linearly between the
+    // centres of neighbouring centroids; the first and last half-centroids
+    // are interpolated towards the exact minimum and maximum.
+    double quantile(double q)
+    {
+        compress();
+        if (centroids.empty())
+        {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        if (centroids.size() == 1)
+        {
+            return centroids[0].mean;
+        }
+        q = std::min(1.0, std::max(0.0, q));
+        double index = q * totalWeight;
+
+        const Centroid &first = centroids.front();
+        if (index < first.weight / 2)
+        {
+            return minValue + (first.mean - minValue) * index / (first.weight / 2);
+        }
+        const Centroid &last = centroids.back();
+        if (index > totalWeight - last.weight / 2)
+        {
+            double tail = totalWeight - index;
+            return maxValue - (maxValue - last.mean) * tail / (last.weight / 2);
+        }
+
+        double cumulative = first.weight / 2;
+        for (std::size_t i = 0; i + 1 < centroids.size(); ++i)
+        {
+            double step = (centroids[i].weight + centroids[i + 1].weight) / 2;
+            if (cumulative + step >= index)
+            {
+                double fraction = (index - cumulative) / step;
+                return centroids[i].mean + (centroids[i + 1].mean - centroids[i].mean) * fraction;
+            }
+            cumulative += step;
+        }
+        return last.mean;
+    }
+
+    std::size_t memoryBytes() const
+    {
+        return (centroids.capacity() + buffer.capacity()) * sizeof(Centroid);
+    }
+};
+
+#endif // T_DIGEST_H
@@ -0,0 +1,186 @@
+#ifndef TOP_K_H
+#define TOP_K_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include "dary_heap.h"
+
+// Streaming top-K: keeps the k largest values seen so far (largest under
+// Compare, std::less by default) in a bounded k-element heap whose top is the
+// smallest kept value. Each offer is O(1) when the value does not qualify and
+// O(log k) when it does; memory is O(k) however long the input is, so values
+// can be fed straight from an istream_iterator or any other input iterator.
+// Partial results from several threads are combined with merge().
+template <typename T, typename Compare = std::less<T>>
+class TopK
+{
+private:
+    // The heap must surface the smallest kept value, so its priority order is
+    // the reverse of Compare.
+    struct Reversed
+    {
+        Compare comp;
+        bool operator()(const T &a, const T &b) const { return comp(b, a); }
+    };
+
+    std::size_t k;
+    Compare comp;
+    DaryHeap<T, 4, Reversed> heap;
+
+public:
+    explicit TopK(std::size_t k, const Compare &compare = Compare())
+        : k(k), comp(compare), heap(Reversed{compare})
+    {
+        heap.reserve(k);
+    }
+
+    void offer(const T &value)
+    {
+        if (heap.size() < k)
+        {
+            heap.push(value);
+        }
+        else if (k > 0 && comp(heap.top(), value))
+        {
+            heap.replaceTop(value);
+        }
+    }
+
+    template <typename InputIt>
+    void offerRange(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+        {
+            offer(*first);
+        }
+    }
+
+    // Folds another partial result (e.g. from another thread) into this one.
+    void merge(const TopK &other)
+    {
+        for (const T &value : other.heap.data())
+        {
+            offer(value);
+        }
+    }
+
+    std::size_t capacity() const { return k; }
+    std::size_t size() const { return heap.size(); }
+    bool full() const { return heap.size() == k; }
+
+    // The k-th largest value seen so far; needs size() == k.
+    const T &kth() const { return heap.top(); }
+
+    // Kept values, largest first.
+    std::vector<T> sorted() const
+    {
+        std::vector<T> result = heap.data();
+        std::sort(result.begin(), result.end(), Reversed{comp});
+        return result;
+    }
+};
+
+// Floyd-Rivest selection: rearranges [first, last) so that *nth is the value
+// a full sort would put there, smaller ones before it and larger ones after
+// (same contract as std::nth_element). Large ranges first recurse on a small
+// sample around the expected position, so the partition pivot is almost
+// always close to nth and the expected cost is n + min(k, n - k) + o(n)
+// comparisons.
+template <typename RandomIt, typename Compare>
+void floydRivestSelect(RandomIt first, RandomIt nth, RandomIt last, Compare comp)
+{
+    typedef typename std::iterator_traits<RandomIt>::difference_type Index;
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    if (last - first < 2 || nth >= last)
+    {
+        return;
+    }
+
+    Index left = 0;
+    Index right = last - first - 1;
+    const Index k = nth - first;
+    while (right > left)
+    {
+        if (right - left > 600)
+        {
+            double n = (double)(right - left + 1);
+            double i = (double)(k - left + 1);
+            double z = std::log(n);
+            double s = 0.5 * std::exp(2 * z / 3);
+            double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1 : 1);
+            Index newLeft = std::max(left, (Index)(k - i * s / n + sd));
+            Index newRight = std::min(right, (Index)(k + (n - i) * s / n + sd));
+            floydRivestSelect(first + newLeft, first + k, first + newRight + 1, comp);
+        }
+
+        T pivot = first[k];
+        Index i = left;
+        Index j = right;
+        std::iter_swap(first + left, first + k);
+        if (comp(pivot, first[right]))
+        {
+            std::iter_swap(first + right, first + left);
+        }
+        while (i < j)
+        {
+            std::iter_swap(first + i, first + j);
+            ++i;
+            --j;
+            while (comp(first[i], pivot))
+                ++i;
+            while (comp(pivot, first[j]))
+                --j;
+        }
+        if (!comp(first[left], pivot) && !comp(pivot, first[left]))
+        {
+            std::iter_swap(first + left, first + j);
+        }
+        else
+        {
+            ++j;
+            std::iter_swap(first + j, first + right);
+        }
+        if (j <= k)
+            left = j + 1;
+        if (k <= j)
+            right = j - 1;
+    }
+}
+
+// Top-k of an in-memory range, computed with one TopK per thread over equal
+// chunks and merged at the end. Returns the values largest first.
+template <typename RandomIt, typename Compare>
+std::vector<typename std::iterator_traits<RandomIt>::value_type>
+parallelTopK(RandomIt first, RandomIt last, std::size_t k, Compare comp,
+             unsigned threads = std::thread::hardware_concurrency())
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    std::size_t n = last - first;
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+    std::vector<TopK<T, Compare>> partial(threads, TopK<T, Compare>(k, comp));
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]()
+                             { partial[t].offerRange(first + n * t / threads, first + n * (t + 1) / threads); });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    for (unsigned t = 1; t < threads; ++t)
+    {
+        partial[0].merge(partial[t]);
+    }
+    return partial[0].sorted();
+}
+
+#endif // TOP_K_H
@@ -0,0 +1,140 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// Helpers shared by the benchmarks in the tree: wall-clock timing, resident
+// memory readings and result rows.
+//
+// A row is a label followed by metrics, each a value with its unit:
+//
+//   report("  build", {{n / seconds / 1e6, "Mops/s"}, {seconds * 1e9 / n, "ns/op"}});
+//
+// prints "  build      12.34 Mops/s     81.03 ns/op" for people, and for
+// `make bench` one structured line per metric:
+//
+//   BENCH,<section>,<label>,<metric>,<value>
+//
+// e.g. "BENCH,16 backends,build,Mops/s,12.3412". The metric is the unit as
+// printed, so a qualifier goes after the unit ("ns p99"); the section is the
+// last one named with benchSection(). Commas in names become semicolons.
+// scripts/bench_report.awk reads only these lines, so the human layout can
+// change freely.
+
+// Seconds taken by body().
+template <typename F>
+double timeIt(F body)
+{
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Current resident set size, from /proc/self/statm; 0 where unavailable.
+inline double residentMiB()
+{
+    long pages = 0, resident = 0;
+    FILE *statm = std::fopen("/proc/self/statm", "r");
+    if (statm != nullptr)
+    {
+        if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2)
+        {
+            resident = 0;
+        }
+        std::fclose(statm);
+    }
+    return resident * (double)sysconf(_SC_PAGESIZE) / 1048576.0;
+}
+
+// Peak resident set size of the process so far (ru_maxrss).
+inline double peakMiB()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+// One value of a result row. The unit is printed after the value;
+// precision is the number of decimals.
+struct Metric
+{
+    double value;
+    std::string unit;
+    int precision;
+
+    Metric(double value, const std::string &unit, int precision = 2) : value(value), unit(unit), precision(precision) {}
+};
+
+namespace bench_detail
+{
+    inline std::string &currentSection()
+    {
+        static std::string section;
+        return section;
+    }
+
+    // A BENCH field: no surrounding blanks, no commas.
+    inline std::string field(const std::string &text)
+    {
+        std::size_t first = text.find_first_not_of(" \t");
+        std::size_t last = text.find_last_not_of(" \t");
+        std::string trimmed = first == std::string::npos ? "" : text.substr(first, last - first + 1);
+        for (char &c : trimmed)
+        {
+            if (c == ',')
+            {
+                c = ';';
+            }
+        }
+        return trimmed;
+    }
+} // namespace bench_detail
+
+// Prints name as a heading, followed by ": detail" if given, and files the
+// following rows under name.
+inline void benchSection(const std::string &name, const std::string &detail = "")
+{
+    bench_detail::currentSection() = name;
+    std::cout << name << (detail.empty() ? "" : ": ") << detail << std::endl;
+}
+
+// Prints the structured line for one measurement only. A value that is not
+// finite (a rate over a zero time at tiny sizes) is left out.
+inline void benchRecord(const std::string &label, const std::string &metric, double value)
+{
+    if (!std::isfinite(value))
+    {
+        return;
+    }
+    std::ostringstream line;
+    line << "BENCH," << bench_detail::field(bench_detail::currentSection()) << "," << bench_detail::field(label) << ","
+         << bench_detail::field(metric) << "," << std::setprecision(6) << value;
+    std::cout << line.str() << std::endl;
+}
+
+// Prints label, padded to labelWidth, then every metric, then the BENCH
+// line of every metric.
+inline void report(const std::string &label, std::initializer_list<Metric> metrics, int labelWidth = 30)
+{
+    std::cout << std::left << std::setw(labelWidth) << label << std::right << std::fixed;
+    for (const Metric &metric : metrics)
+    {
+        std::cout << std::setw(12) << std::setprecision(metric.precision) << metric.value << " " << metric.unit;
+    }
+    std::cout << std::endl;
+    for (const Metric &metric : metrics)
+    {
+        benchRecord(label, metric.unit, metric.value);
+    }
+}
+
+#endif // BENCH_UTIL_H
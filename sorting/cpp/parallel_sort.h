@@ -0,0 +1,358 @@
+#ifndef PARALLEL_SORT_H
+#define PARALLEL_SORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../../Tree/dary_heap.h"
+
+// Comparison sorts over random-access ranges, generic over the element type
+// and the comparator (std::sort conventions: comp(a, b) == "a goes before b").
+//
+//   heapSort      - in-place, O(n log n) worst case, iterative 4-ary heap
+//   networkSort   - branchless Batcher odd-even merge network for tiny ranges
+//   introSort     - quicksort with median-of-three, networkSort leaves and a
+//                   heapSort fallback once recursion gets too deep
+//   parallelSort  - sort one chunk per thread with introSort, split the chunks
+//                   at common splitters and k-way merge every part in parallel
+
+const std::size_t kNetworkSortMax = 16;
+const std::size_t kParallelSortMinChunk = 1 << 14;
+
+namespace sort_detail
+{
+    const std::size_t kHeapArity = 4;
+
+    // Scalars are exchanged with selects instead of a branch, so independent
+    // comparators of one network layer can be turned into vector min/max.
+    template <typename T, typename Compare>
+    inline void compareExchange(T &a, T &b, Compare comp, std::true_type)
+    {
+        bool swapNeeded = comp(b, a);
+        T low = swapNeeded ? b : a;
+        T high = swapNeeded ? a : b;
+        a = low;
+        b = high;
+    }
+
+    template <typename T, typename Compare>
+    inline void compareExchange(T &a, T &b, Compare comp, std::false_type)
+    {
+        if (comp(b, a))
+        {
+            std::swap(a, b);
+        }
+    }
+
+    template <typename RandomIt, typename Compare>
+    void siftDown(RandomIt first, std::size_t n, std::size_t index, Compare comp)
+    {
+        typename std::iterator_traits<RandomIt>::value_type value = std::move(first[index]);
+        while (true)
+        {
+            std::size_t child = kHeapArity * index + 1;
+            if (child >= n)
+            {
+                break;
+            }
+            std::size_t last = child + kHeapArity < n ? child + kHeapArity : n;
+            std::size_t best = child;
+            for (++child; child < last; ++child)
+            {
+                if (comp(first[best], first[child]))
+                {
+                    best = child;
+                }
+            }
+            if (!comp(value, first[best]))
+            {
+                break;
+            }
+            first[index] = std::move(first[best]);
+            index = best;
+        }
+        first[index] = std::move(value);
+    }
+
+    // Puts the median of a, b, c into *result.
+    template <typename RandomIt, typename Compare>
+    void moveMedianToFirst(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare comp)
+    {
+        if (comp(*a, *b))
+        {
+            if (comp(*b, *c))
+                std::iter_swap(result, b);
+            else if (comp(*a, *c))
+                std::iter_swap(result, c);
+            else
+                std::iter_swap(result, a);
+        }
+        else if (comp(*a, *c))
+            std::iter_swap(result, a);
+        else if (comp(*b, *c))
+            std::iter_swap(result, c);
+        else
+            std::iter_swap(result, b);
+    }
+
+    // Hoare partition of [first, last) around *pivot. The median-of-three
+    // placement guarantees both scans stop inside the range.
+    template <typename RandomIt, typename Compare>
+    RandomIt partition(RandomIt first, RandomIt last, RandomIt pivot, Compare comp)
+    {
+        while (true)
+        {
+            while (comp(*first, *pivot))
+                ++first;
+            --last;
+            while (comp(*pivot, *last))
+                --last;
+            if (!(first < last))
+                return first;
+            std::iter_swap(first, last);
+            ++first;
+        }
+    }
+
+    template <typename RandomIt, typename Compare>
+    void introSortLoop(RandomIt first, RandomIt last, int depthLimit, Compare comp);
+
+    template <typename Function>
+    void runParallel(unsigned threads, Function body)
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t)
+        {
+            workers.emplace_back(body, t);
+        }
+        body(0);
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void heapSort(RandomIt first, RandomIt last, Compare comp)
+{
+    std::size_t n = last - first;
+    if (n < 2)
+    {
+        return;
+    }
+    const std::size_t arity = sort_detail::kHeapArity;
+    for (std::size_t i = (n - 2) / arity + 1; i-- > 0;)
+    {
+        sort_detail::siftDown(first, n, i, comp);
+    }
+    for (std::size_t end = n - 1; end > 0; --end)
+    {
+        std::iter_swap(first, first + end);
+        sort_detail::siftDown(first, end, 0, comp);
+    }
+}
+
+template <typename RandomIt>
+void heapSort(RandomIt first, RandomIt last)
+{
+    heapSort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+// Batcher's odd-even merge sort network for any n. Meant for ranges of at
+// most kNetworkSortMax elements (63 comparators for 16); it is O(n log^2 n).
+template <typename RandomIt, typename Compare>
+void networkSort(RandomIt first, RandomIt last, Compare comp)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    typedef std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_pointer<T>::value> Branchless;
+
+    std::size_t n = last - first;
+    for (std::size_t p = 1; p < n; p <<= 1)
+    {
+        for (std::size_t k = p; k >= 1; k >>= 1)
+        {
+            for (std::size_t j = k % p; j + k < n; j += 2 * k)
+            {
+                std::size_t limit = std::min(k, n - j - k);
+                for (std::size_t i = 0; i < limit; ++i)
+                {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                    {
+                        sort_detail::compareExchange(first[i + j], first[i + j + k], comp, Branchless());
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void sort_detail::introSortLoop(RandomIt first, RandomIt last, int depthLimit, Compare comp)
+{
+    while ((std::size_t)(last - first) > kNetworkSortMax)
+    {
+        if (depthLimit == 0)
+        {
+            heapSort(first, last, comp);
+            return;
+        }
+        --depthLimit;
+        RandomIt mid = first + (last - first) / 2;
+        moveMedianToFirst(first, first + 1, mid, last - 1, comp);
+        RandomIt cut = partition(first + 1, last, first, comp);
+
+        // Recurse into the smaller side so the stack stays O(log n).
+        if (cut - first < last - cut)
+        {
+            introSortLoop(first, cut, depthLimit, comp);
+            first = cut;
+        }
+        else
+        {
+            introSortLoop(cut, last, depthLimit, comp);
+            last = cut;
+        }
+    }
+    networkSort(first, last, comp);
+}
+
+template <typename RandomIt, typename Compare>
+void introSort(RandomIt first, RandomIt last, Compare comp)
+{
+    int depthLimit = 0;
+    for (std::size_t n = last - first; n > 1; n >>= 1)
+    {
+        depthLimit += 2;
+    }
+    sort_detail::introSortLoop(first, last, depthLimit, comp);
+}
+
+template <typename RandomIt>
+void introSort(RandomIt first, RandomIt last)
+{
+    introSort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+// Parallel sort with regular sampling:
+//   1. split the range into `threads` chunks and introSort each one,
+//   2. pick threads - 1 splitters from evenly spaced samples of the chunks,
+//   3. cut every chunk at the splitters with lower_bound, so part p of the
+//      output is the union of piece p of all chunks,
+//   4. each thread k-way merges its pieces into a buffer through a DaryHeap of
+//      run cursors, and after all merges finish moves its part back.
+// Needs n extra elements of scratch space.
+template <typename RandomIt, typename Compare>
+void parallelSort(RandomIt first, RandomIt last, Compare comp,
+                  unsigned threads = std::thread::hardware_concurrency())
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    std::size_t n = last - first;
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+    if (n / kParallelSortMinChunk < threads)
+    {
+        threads = (unsigned)std::max<std::size_t>(1, n / kParallelSortMinChunk);
+    }
+    if (threads == 1)
+    {
+        introSort(first, last, comp);
+        return;
+    }
+
+    std::vector<std::size_t> bounds(threads + 1);
+    for (unsigned t = 0; t <= threads; ++t)
+    {
+        bounds[t] = n * t / threads;
+    }
+    sort_detail::runParallel(threads, [&](unsigned t)
+                             { introSort(first + bounds[t], first + bounds[t + 1], comp); });
+
+    // Oversample so parts stay balanced even for skewed chunks.
+    const std::size_t perChunk = 4 * threads;
+    std::vector<T> samples;
+    samples.reserve(perChunk * threads);
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        std::size_t length = bounds[t + 1] - bounds[t];
+        for (std::size_t s = 1; s <= perChunk; ++s)
+        {
+            samples.push_back(first[bounds[t] + length * s / (perChunk + 1)]);
+        }
+    }
+    introSort(samples.begin(), samples.end(), comp);
+
+    // cuts[c * (threads + 1) + p] = start of piece p inside chunk c.
+    std::vector<std::size_t> cuts((threads + 1) * threads);
+    for (unsigned c = 0; c < threads; ++c)
+    {
+        std::size_t *row = &cuts[c * (threads + 1)];
+        row[0] = bounds[c];
+        row[threads] = bounds[c + 1];
+        for (unsigned p = 1; p < threads; ++p)
+        {
+            const T &splitter = samples[p * samples.size() / threads];
+            row[p] = std::lower_bound(first + row[p - 1], first + bounds[c + 1], splitter, comp) - first;
+        }
+    }
+    std::vector<std::size_t> offsets(threads + 1, 0);
+    for (unsigned p = 0; p < threads; ++p)
+    {
+        offsets[p + 1] = offsets[p];
+        for (unsigned c = 0; c < threads; ++c)
+        {
+            offsets[p + 1] += cuts[c * (threads + 1) + p + 1] - cuts[c * (threads + 1) + p];
+        }
+    }
+
+    std::vector<T> buffer(n);
+    sort_detail::runParallel(threads, [&](unsigned p)
+                             {
+        std::vector<std::size_t> cursor(threads), end(threads);
+        for (unsigned c = 0; c < threads; ++c)
+        {
+            cursor[c] = cuts[c * (threads + 1) + p];
+            end[c] = cuts[c * (threads + 1) + p + 1];
+        }
+        // The heap holds run numbers; the run whose head sorts first is on top.
+        auto later = [&](unsigned a, unsigned b)
+        { return comp(first[cursor[b]], first[cursor[a]]); };
+        DaryHeap<unsigned, 4, decltype(later)> runs(later);
+        for (unsigned c = 0; c < threads; ++c)
+        {
+            if (cursor[c] < end[c])
+            {
+                runs.push(c);
+            }
+        }
+        std::size_t out = offsets[p];
+        while (!runs.empty())
+        {
+            unsigned c = runs.extractTop();
+            buffer[out++] = std::move(first[cursor[c]++]);
+            if (cursor[c] < end[c])
+            {
+                runs.push(c);
+            }
+        } });
+    // Only once every part is merged: other threads read their pieces from
+    // the whole input range until then.
+    sort_detail::runParallel(threads, [&](unsigned p)
+                             { std::move(buffer.begin() + offsets[p], buffer.begin() + offsets[p + 1], first + offsets[p]); });
+}
+
+template <typename RandomIt>
+void parallelSort(RandomIt first, RandomIt last)
+{
+    parallelSort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+#endif // PARALLEL_SORT_H
@@ -0,0 +1,75 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <cstdlib>
+#include "parallel_sort.h"
+#include "../../bench/bench_util.h"
+
+using namespace std;
+
+// Sorts the same random input with std::sort, heapSort, introSort and
+// parallelSort at 1, 2, 4, ... threads and reports ns per element.
+//
+// Usage: ./sort_benchmark [n] [maxThreads]
+//        (default n = 10000000; pass 100000000 for the 100M run, which needs
+//        ~1.2 GB: input, working copy and parallelSort's buffer)
+
+void report(const string &label, size_t n, double seconds)
+{
+    report(label, {{seconds * 1e9 / n, "ns/op"}}, 32);
+}
+
+template <typename T, typename Sorter>
+void bench(const string &label, const vector<T> &input, Sorter sorter)
+{
+    vector<T> data = input;
+    double seconds = timeIt([&]()
+                            { sorter(data); });
+    report(label, data.size(), seconds);
+    if (!is_sorted(data.begin(), data.end()))
+    {
+        cout << "  ^ output is NOT sorted" << endl;
+        exit(1);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    unsigned maxThreads = argc > 2 ? atoi(argv[2]) : thread::hardware_concurrency();
+    if (maxThreads == 0)
+    {
+        maxThreads = 1;
+    }
+
+    mt19937_64 rng(1);
+    vector<unsigned> keys(n);
+    for (unsigned &key : keys)
+    {
+        key = (unsigned)rng();
+    }
+
+    bench("std::sort", keys, [](vector<unsigned> &v)
+          { sort(v.begin(), v.end()); });
+    bench("heapSort", keys, [](vector<unsigned> &v)
+          { heapSort(v.begin(), v.end()); });
+    bench("introSort", keys, [](vector<unsigned> &v)
+          { introSort(v.begin(), v.end()); });
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        bench("parallelSort x" + to_string(threads), keys, [threads](vector<unsigned> &v)
+              { parallelSort(v.begin(), v.end(), less<unsigned>(), threads); });
+    }
+
+    // Already sorted and all-equal inputs must not degrade.
+    vector<unsigned> sortedKeys(keys);
+    sort(sortedKeys.begin(), sortedKeys.end());
+    bench("introSort (sorted input)", sortedKeys, [](vector<unsigned> &v)
+          { introSort(v.begin(), v.end()); });
+    vector<unsigned> equalKeys(n, 7);
+    bench("introSort (all equal)", equalKeys, [](vector<unsigned> &v)
+          { introSort(v.begin(), v.end()); });
+    return 0;
+}
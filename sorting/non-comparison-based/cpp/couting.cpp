@@ -17,7 +17,7 @@ void countingSort(vector<int> &arr)
 
     vector<int> count(range, 0);
 
-    for (int i = 0; i < arr.size(); i++)
+    for (size_t i = 0; i < arr.size(); i++)
     {
         count[arr[i] - minElem]++;
     }
@@ -35,7 +35,7 @@ void countingSort(vector<int> &arr)
         count[arr[i] - minElem]--;
     }
 
-    for (int i = 0; i < arr.size(); i++)
+    for (size_t i = 0; i < arr.size(); i++)
     {
         arr[i] = output[i];
     }